@@ -0,0 +1,862 @@
+/*
+ * ChiLow Independent Implementation - Benchmark Suite
+ * 
+ * Throughput measurements for the scalar and batch decryption paths
+ * 
+ * Author: Hosein Hadipour <hsn.hadipour@gmail.com>
+ * Date: September 2025
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#define NO_MAIN  /* Prevent main function from being compiled */
+#include "chilow.c"
+
+#include <stdio.h>
+#include <time.h>
+
+/* Blocks per measurement */
+#define BENCH_BLOCKS (1 << 16)
+
+static uint32_t bench_c32[BENCH_BLOCKS];
+static uint64_t bench_c40[BENCH_BLOCKS];
+static uint64_t bench_tweaks[BENCH_BLOCKS];
+static uint64_t bench_keys_hi[BENCH_BLOCKS];
+static uint64_t bench_keys_lo[BENCH_BLOCKS];
+static uint64_t bench_out[BENCH_BLOCKS];
+
+static const uint64_t BENCH_KEY_HI = 0xFEDCBA9876543210ULL;
+static const uint64_t BENCH_KEY_LO = 0x7766554433221100ULL;
+
+/* Accumulated output so the compiler cannot discard the measured work */
+static volatile uint64_t bench_sink;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void fill_inputs(void) {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        bench_c32[i] = (uint32_t)x;
+        bench_c40[i] = x & BITMASK_40;
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        bench_tweaks[i] = x;
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        bench_keys_hi[i] = x;
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        bench_keys_lo[i] = x;
+    }
+}
+
+static void report(const char* name, size_t blocks, double seconds) {
+    printf("  %-36s %10.2f Mblocks/s  %8.1f ns/block\n",
+           name, blocks / seconds / 1e6, seconds * 1e9 / blocks);
+}
+
+static void bench_scalar(int repeat) {
+    double start = now_seconds();
+    uint64_t acc = 0;
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_decrypt_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO);
+        }
+    }
+    report("chilow_decrypt_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_decrypt_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO);
+        }
+    }
+    report("chilow_decrypt_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_encrypt_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO);
+        }
+    }
+    report("chilow_encrypt_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_encrypt_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO);
+        }
+    }
+    report("chilow_encrypt_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    /* Round-state capture into one reused trace (the capture cost, not memory bandwidth) */
+    chilow_trace_t trace;
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_trace_decrypt_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, &trace);
+        }
+    }
+    report("chilow_trace_decrypt_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink = acc ^ trace.rounds[0].nonlinear.plaintext;
+}
+
+static void bench_round_conventions(int repeat) {
+    static const struct {
+        const char* name;
+        uint64_t (*fn32)(uint32_t, uint64_t, uint64_t, uint64_t, int);
+        uint64_t (*fn40)(uint64_t, uint64_t, uint64_t, uint64_t, int);
+    } conventions[] = {
+        {"reduced_round", chilow_reduced_round_32bit, chilow_reduced_round_40bit},
+        {"half_reduced_round", chilow_half_reduced_round_32bit, chilow_half_reduced_round_40bit},
+        {"complete_rounds", chilow_complete_rounds_32bit, chilow_complete_rounds_40bit},
+    };
+    const int rounds[] = {2, 4, 6, 8};
+    uint64_t acc = 0;
+    char name[64];
+
+    for (size_t c = 0; c < sizeof(conventions) / sizeof(conventions[0]); c++) {
+        for (size_t k = 0; k < sizeof(rounds) / sizeof(rounds[0]); k++) {
+            double start = now_seconds();
+            for (int r = 0; r < repeat; r++) {
+                for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+                    acc ^= conventions[c].fn32(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds[k]);
+                }
+            }
+            snprintf(name, sizeof(name), "%s_32bit (r=%d)", conventions[c].name, rounds[k]);
+            report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+            start = now_seconds();
+            for (int r = 0; r < repeat; r++) {
+                for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+                    acc ^= conventions[c].fn40(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds[k]);
+                }
+            }
+            snprintf(name, sizeof(name), "%s_40bit (r=%d)", conventions[c].name, rounds[k]);
+            report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        }
+    }
+    bench_sink = acc;
+}
+
+/* One "block" here is all 27 outputs (3 conventions x round counts 0..8) of one ciphertext */
+static void bench_round_sweep(int repeat) {
+    chilow_round_sweep_t sweep;
+    uint64_t acc = 0;
+    double start;
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            for (int rounds = 0; rounds <= NUM_ROUNDS; rounds++) {
+                acc ^= chilow_reduced_round_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+                acc ^= chilow_half_reduced_round_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+                acc ^= chilow_complete_rounds_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+            }
+        }
+    }
+    report("per-round-count calls_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            chilow_round_sweep_32bit(bench_c32[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, &sweep);
+            acc ^= sweep.reduced[NUM_ROUNDS] ^ sweep.half_reduced[1] ^ sweep.complete[NUM_ROUNDS];
+        }
+    }
+    report("round_sweep_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            for (int rounds = 0; rounds <= NUM_ROUNDS; rounds++) {
+                acc ^= chilow_reduced_round_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+                acc ^= chilow_half_reduced_round_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+                acc ^= chilow_complete_rounds_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, rounds);
+            }
+        }
+    }
+    report("per-round-count calls_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            chilow_round_sweep_40bit(bench_c40[i], bench_tweaks[i], BENCH_KEY_HI, BENCH_KEY_LO, &sweep);
+            acc ^= sweep.reduced[NUM_ROUNDS] ^ sweep.half_reduced[1] ^ sweep.complete[NUM_ROUNDS];
+        }
+    }
+    report("round_sweep_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink = acc;
+}
+
+static void bench_cube(int repeat) {
+    /* 16 active bits spread over a 40-bit input: 2^16 elements per pass */
+    static const int positions[16] = {0, 2, 3, 5, 8, 11, 13, 17, 19, 23, 26, 29, 31, 34, 37, 39};
+    uint64_t mask = 0, element, acc = 0;
+    chilow_cube_t cube;
+    double start;
+
+    for (int j = 0; j < 16; j++) mask |= 1ULL << positions[j];
+    chilow_cube_init(&cube, bench_c40[0], mask);
+
+    /* Baseline: rebuild each element bit by bit from its counter */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (uint64_t i = 0; i < cube.size; i++) {
+            element = cube.base;
+            for (int j = 0; j < 16; j++) element |= ((i >> j) & 1) << positions[j];
+            acc += element;
+        }
+    }
+    report("per-bit loop over 16 positions", (size_t)repeat * cube.size, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (uint64_t i = 0; i < cube.size; i++) acc += chilow_cube_element(&cube, i);
+    }
+    report("chilow_cube_element (deposit)", (size_t)repeat * cube.size, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_cube_seek(&cube, 0);
+        while (chilow_cube_next(&cube, &element)) acc += element;
+    }
+    report("chilow_cube_next (Gray code)", (size_t)repeat * cube.size, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_cube_seek(&cube, 0);
+        while (chilow_cube_fill(&cube, bench_out, BENCH_BLOCKS) > 0) acc += bench_out[r];
+    }
+    report("chilow_cube_fill (Gray code)", (size_t)repeat * cube.size, now_seconds() - start);
+    bench_sink = acc;
+}
+
+static void bench_cube_sum(int repeat) {
+    uint64_t acc = 0;
+    chilow_cube_t cube;
+    double start;
+
+    /* 2^16-element cubes over the low bits, 8 complete rounds */
+    chilow_cube_init(&cube, bench_c40[1], 0xFFFFULL);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        acc ^= chilow_cube_sum_32bit(&cube, 0, cube.size, bench_tweaks[r], BENCH_KEY_HI, BENCH_KEY_LO, 8, NULL);
+    }
+    report("chilow_cube_sum_32bit", (size_t)repeat * cube.size, now_seconds() - start);
+
+    /* Every round count 0..8 from the same pass (the integral scan) */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        uint64_t sums[CHILOW_NUM_ROUNDS + 1];
+        acc ^= chilow_cube_sum_32bit(&cube, 0, cube.size, bench_tweaks[r], BENCH_KEY_HI, BENCH_KEY_LO, 8, sums);
+    }
+    report("chilow_cube_sum_32bit (rounds 0..8)", (size_t)repeat * cube.size, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        acc ^= chilow_cube_sum_40bit(&cube, 0, cube.size, bench_tweaks[r], BENCH_KEY_HI, BENCH_KEY_LO, 8, NULL);
+    }
+    report("chilow_cube_sum_40bit", (size_t)repeat * cube.size, now_seconds() - start);
+
+    /* Baseline: one complete-rounds call per element; the volatile tweak keeps
+     * the compiler from hoisting the schedule out of the inlined call */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        volatile uint64_t tweak = bench_tweaks[r];
+        for (uint64_t i = 0; i < cube.size; i++) {
+            acc ^= chilow_complete_rounds_32bit((uint32_t)(cube.base | i), tweak, BENCH_KEY_HI,
+                                                BENCH_KEY_LO, 8);
+        }
+    }
+    report("chilow_complete_rounds_32bit loop", (size_t)repeat * cube.size, now_seconds() - start);
+
+    /* Per element with the tweak and key schedule hoisted out of the loop */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_integral_t integral;
+        chilow_integral_init_32bit(&integral, bench_tweaks[r], BENCH_KEY_HI, BENCH_KEY_LO);
+        for (uint64_t i = 0; i < cube.size; i++) {
+            acc ^= chilow_integral_rounds_32bit(&integral, (uint32_t)(cube.base | i), 8, NULL);
+        }
+    }
+    report("chilow_integral_rounds_32bit loop", (size_t)repeat * cube.size, now_seconds() - start);
+    bench_sink = acc;
+}
+
+static void bench_ctx(int repeat) {
+    chilow_ctx_t ctx;
+    uint64_t acc = 0;
+    double start;
+
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_ctx_decrypt_32bit(&ctx, bench_c32[i], bench_tweaks[i]);
+        }
+    }
+    report("chilow_ctx_decrypt_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_ctx_decrypt_40bit(&ctx, bench_c40[i], bench_tweaks[i]);
+        }
+    }
+    report("chilow_ctx_decrypt_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat * 16; r++) {
+        chilow_ctx_init(&ctx, BENCH_KEY_HI ^ (uint64_t)r, BENCH_KEY_LO);
+        acc ^= ctx.round_keys_32[NUM_ROUNDS - 1];
+    }
+    report("chilow_ctx_init", (size_t)repeat * 16, now_seconds() - start);
+    bench_sink = acc;
+}
+
+static void bench_key_path_one(const char* name, uint128_t (*round)(uint128_t, uint64_t),
+                               int repeat) {
+    uint128_t key = {BENCH_KEY_LO, BENCH_KEY_HI};
+    size_t updates = (size_t)repeat * BENCH_BLOCKS;
+    double start = now_seconds();
+
+    /* Dependent chain: each update consumes the previous key */
+    for (size_t i = 0; i < updates; i++) {
+        key = round(key, ROUND_CONSTANTS[i & 7]);
+    }
+    report(name, updates, now_seconds() - start);
+    bench_sink ^= key.lo ^ key.hi;
+}
+
+static void bench_key_path(int repeat) {
+    bench_key_path_one("key update, two uint64_t words", key_round_words, repeat);
+#ifdef CHILOW_HAVE_INT128
+    bench_key_path_one("key update, unsigned __int128", key_round_int128, repeat);
+#endif
+#ifdef CHILOW_HAVE_X86_SIMD
+    bench_key_path_one("key update, SSE2 __m128i", key_round_sse, repeat);
+#endif
+}
+
+#ifdef CHILOW_JIT
+static void bench_jit(int repeat) {
+    chilow_jit_t jit;
+    uint64_t acc = 0;
+    double start;
+
+    /* A fresh key hash forces one compile; the second init loads the cached kernel */
+    uint64_t key_hi = BENCH_KEY_HI ^ (uint64_t)time(NULL);
+    start = now_seconds();
+    if (chilow_jit_init(&jit, key_hi, BENCH_KEY_LO, NULL) != 0) {
+        printf("  chilow_jit_init failed (no compiler or cache directory)\n");
+        return;
+    }
+    printf("  %-36s %10.1f ms\n", "chilow_jit_init (compile)", 1e3 * (now_seconds() - start));
+    chilow_jit_free(&jit);
+
+    start = now_seconds();
+    if (chilow_jit_init(&jit, key_hi, BENCH_KEY_LO, NULL) != 0) return;
+    printf("  %-36s %10.1f ms\n", "chilow_jit_init (cached)", 1e3 * (now_seconds() - start));
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= jit.decrypt_32bit(bench_c32[i], bench_tweaks[i]);
+        }
+    }
+    report("jit decrypt_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        jit.decrypt_32bit_batch(bench_c32, bench_tweaks, bench_out, BENCH_BLOCKS);
+        acc ^= bench_out[r];
+    }
+    report("jit decrypt_32bit_batch", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    chilow_jit_free(&jit);
+    bench_sink = acc;
+}
+#endif
+
+static void bench_tweak_cache(int repeat) {
+    const size_t working_sets[] = {16, 128, 4096};
+    static chilow_ctx_t ctx;
+    static chilow_tweak_cache_t cache;
+    uint64_t acc = 0;
+    char name[64];
+
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+
+    /* Ciphertexts cycle through a working set of tweaks (hit rate depends on its size) */
+    for (size_t w = 0; w < sizeof(working_sets) / sizeof(working_sets[0]); w++) {
+        size_t set = working_sets[w];
+        double start;
+
+        chilow_tweak_cache_init(&cache, &ctx);
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+                acc ^= chilow_cached_decrypt_32bit(&cache, bench_c32[i], bench_tweaks[i % set]);
+            }
+        }
+        snprintf(name, sizeof(name), "cached_decrypt_32bit (%zu tweaks)", set);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        printf("    hit rate %.1f%%\n", 100.0 * (double)cache.hits / (double)(cache.hits + cache.misses));
+
+        chilow_tweak_cache_init(&cache, &ctx);
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+                acc ^= chilow_cached_decrypt_40bit(&cache, bench_c40[i], bench_tweaks[i % set]);
+            }
+        }
+        snprintf(name, sizeof(name), "cached_decrypt_40bit (%zu tweaks)", set);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        printf("    hit rate %.1f%%\n", 100.0 * (double)cache.hits / (double)(cache.hits + cache.misses));
+    }
+    bench_sink = acc;
+}
+
+static void bench_bitsliced(int repeat) {
+    const size_t batches[] = {64, 256, 512};
+
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        char name[64];
+        double start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i += batches[b]) {
+                chilow_decrypt_32bit_bitsliced(bench_c32 + i, bench_tweaks + i, BENCH_KEY_HI,
+                                               BENCH_KEY_LO, bench_out + i, batches[b]);
+            }
+        }
+        snprintf(name, sizeof name, "chilow_decrypt_32bit_bitsliced/%zu", batches[b]);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0];
+
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i += batches[b]) {
+                chilow_decrypt_40bit_bitsliced(bench_c40 + i, bench_tweaks + i, BENCH_KEY_HI,
+                                               BENCH_KEY_LO, bench_out + i, batches[b]);
+            }
+        }
+        snprintf(name, sizeof name, "chilow_decrypt_40bit_bitsliced/%zu", batches[b]);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0];
+    }
+}
+
+static void bench_engine(int repeat) {
+    static uint64_t tags[BENCH_BLOCKS];
+    const struct { const char* name; int width, rounds, tag; } specs[] = {
+        {"engine ChiLow-(32+tau), 8 rounds", 32, 8, 1},
+        {"engine ChiLow-40, 8 rounds", 40, 8, 0},
+        {"engine 24+tau, 8 rounds", 24, 8, 1},
+        {"engine 48+tau, 12 rounds", 48, 12, 1},
+        {"engine 64, 16 rounds", 64, 16, 0},
+    };
+    chilow_engine_t engine;
+    double start;
+
+    for (size_t s = 0; s < sizeof(specs) / sizeof(specs[0]); s++) {
+        chilow_spec_t spec;
+        if (specs[s].width == 40) {
+            chilow_spec_init_40bit(&spec);
+        } else {
+            chilow_spec_init_32bit(&spec);
+        }
+        spec.state_width = specs[s].width;
+        spec.num_rounds = specs[s].rounds;
+        spec.tag = specs[s].tag;
+        chilow_engine_init(&engine, &spec, BENCH_KEY_HI, BENCH_KEY_LO);
+
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            chilow_engine_decrypt(&engine, bench_c40, bench_tweaks, bench_out, tags, BENCH_BLOCKS);
+        }
+        report(specs[s].name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0] ^ tags[0];
+    }
+
+    /* Baseline: the fixed-width bitsliced engine */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_decrypt_32bit_bitsliced(bench_c32, bench_tweaks, BENCH_KEY_HI, BENCH_KEY_LO, bench_out,
+                                       BENCH_BLOCKS);
+    }
+    report("chilow_decrypt_32bit_bitsliced", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= bench_out[0];
+}
+
+static void bench_verify(int repeat) {
+    static uint32_t tags[BENCH_BLOCKS], plaintexts[BENCH_BLOCKS];
+    static uint64_t bitmap[BENCH_BLOCKS / 64];
+    size_t verified = 0;
+    double start;
+
+    chilow_decrypt_32bit_bitsliced(bench_c32, bench_tweaks, BENCH_KEY_HI, BENCH_KEY_LO, bench_out, BENCH_BLOCKS);
+    for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+        tags[i] = (uint32_t)(bench_out[i] >> 32) ^ (uint32_t)(i % 16 == 0);
+    }
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        verified += chilow_verify_32bit_batch(bench_c32, bench_tweaks, tags, BENCH_KEY_HI, BENCH_KEY_LO,
+                                              bitmap, NULL, BENCH_BLOCKS);
+    }
+    report("verify_32bit_batch (bitmap)", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        verified += chilow_verify_32bit_batch(bench_c32, bench_tweaks, tags, BENCH_KEY_HI, BENCH_KEY_LO,
+                                              bitmap, plaintexts, BENCH_BLOCKS);
+    }
+    report("verify_32bit_batch (+ plaintexts)", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    /* Baseline: full 8-byte outputs, then a compare loop */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_decrypt_32bit_bitsliced(bench_c32, bench_tweaks, BENCH_KEY_HI, BENCH_KEY_LO, bench_out, BENCH_BLOCKS);
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            verified += (uint32_t)(bench_out[i] >> 32) == tags[i];
+        }
+    }
+    report("decrypt_32bit_bitsliced + compare", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            verified += (size_t)chilow_verify_32bit(bench_c32[i], bench_tweaks[i], tags[i], BENCH_KEY_HI,
+                                                    BENCH_KEY_LO, NULL);
+        }
+    }
+    report("chilow_verify_32bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= verified;
+}
+
+#define BENCH_PAGE_WORDS 1024   /* one 4 KiB page of 32-bit words */
+
+static void report_pages(const char* name, size_t pages, double seconds) {
+    printf("  %-36s %10.0f pages/s    %8.2f us/page\n",
+           name, pages / seconds, seconds * 1e6 / pages);
+}
+
+static void bench_memory(int repeat) {
+    static uint32_t page[BENCH_PAGE_WORDS], tags[BENCH_PAGE_WORDS];
+    const size_t pages = (size_t)repeat * (BENCH_BLOCKS / BENCH_PAGE_WORDS);
+    const uint64_t base = 0x7F0000000000ULL;
+    chilow_ctx_t ctx;
+    size_t failures = 0;
+    double start;
+
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+    memcpy(page, bench_c32, sizeof page);
+
+    start = now_seconds();
+    for (size_t p = 0; p < pages; p++) {
+        chilow_memory_encrypt_32bit(&ctx, base + 4096 * p, 1, page, page, tags, BENCH_PAGE_WORDS);
+    }
+    report_pages("memory_encrypt_32bit (4 KiB)", pages, now_seconds() - start);
+
+    start = now_seconds();
+    for (size_t p = 0; p < pages; p++) {
+        failures += chilow_memory_decrypt_32bit(&ctx, base + 4096 * p, 1, page, tags, page, BENCH_PAGE_WORDS);
+    }
+    report_pages("memory_decrypt_32bit (4 KiB)", pages, now_seconds() - start);
+
+    start = now_seconds();
+    for (size_t p = 0; p < pages; p++) {
+        chilow_memory_encrypt_32bit(&ctx, base, 1, page, page, tags, BENCH_PAGE_WORDS);
+        failures += chilow_memory_decrypt_32bit(&ctx, base, 1, page, tags, page, BENCH_PAGE_WORDS);
+    }
+    report_pages("memory round trip (4 KiB)", pages, now_seconds() - start);
+
+    /* Baseline: scalar encryption word by word */
+    start = now_seconds();
+    for (size_t p = 0; p < pages; p++) {
+        for (size_t i = 0; i < BENCH_PAGE_WORDS; i++) {
+            uint64_t result = chilow_encrypt_32bit(page[i], chilow_memory_tweak(base, i, 1),
+                                                   BENCH_KEY_HI, BENCH_KEY_LO);
+            page[i] = (uint32_t)result;
+            tags[i] = (uint32_t)(result >> 32);
+        }
+    }
+    report_pages("chilow_encrypt_32bit per word (4 KiB)", pages, now_seconds() - start);
+    bench_sink ^= failures ^ page[0] ^ tags[0];
+}
+
+static void bench_pac(int repeat) {
+    static uint64_t pointers[BENCH_BLOCKS], signed_pointers[BENCH_BLOCKS];
+    const chilow_pac_t pac = {0xFFFF000000000000ULL, 0x5A5A000000000000ULL, 0xF};
+    chilow_ctx_t ctx;
+    size_t failures = 0;
+    double start;
+
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+    for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+        pointers[i] = 0x00007F0000000000ULL | (bench_c40[i] & ~0xFULL);
+    }
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_pac_sign_40bit(&ctx, &pac, pointers, bench_tweaks, signed_pointers, BENCH_BLOCKS);
+    }
+    report("pac_sign_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        failures += chilow_pac_auth_40bit(&ctx, &pac, signed_pointers, bench_tweaks, bench_out, BENCH_BLOCKS);
+    }
+    report("pac_auth_40bit", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    /* Baseline: scalar decryption and checks pointer by pointer */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            uint64_t high = signed_pointers[i] & ~BITMASK_40;
+            uint64_t low = chilow_decrypt_40bit(signed_pointers[i] & BITMASK_40, bench_tweaks[i] ^ high,
+                                                BENCH_KEY_HI, BENCH_KEY_LO);
+            failures += (high & pac.check_mask) != pac.check || (low & pac.zero_mask) != 0;
+            bench_out[i] = (high & ~pac.check_mask) | low;
+        }
+    }
+    report("chilow_decrypt_40bit + checks", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= failures ^ bench_out[0];
+}
+
+static void bench_prf(int repeat) {
+    static uint8_t stream[4 * BENCH_BLOCKS];
+    chilow_ctx_t ctx;
+    chilow_prf_t prf;
+    uint64_t acc = 0;
+    double start;
+
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+    chilow_prf_init(&prf, &ctx, 1);
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_prf_generate(&prf, stream, sizeof stream);
+        acc ^= stream[r];
+    }
+    report("prf_generate (4 bytes/block)", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+
+    /* Baseline: one chilow_decrypt_32bit call per counter block */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            acc ^= chilow_decrypt_32bit((uint32_t)i, (uint64_t)1 << 32, BENCH_KEY_HI, BENCH_KEY_LO) >> 32;
+        }
+    }
+    report("chilow_decrypt_32bit tag per block", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= acc;
+}
+
+static void bench_strided(int repeat) {
+    /* 40-byte records; the result goes into the tag slot */
+    typedef struct {
+        uint64_t tweak;
+        uint32_t ciphertext;
+        uint32_t flags;
+        uint64_t key_hi, key_lo;
+        uint64_t tag;
+    } record_t;
+    static record_t records[BENCH_BLOCKS];
+    static uint32_t packed_c32[BENCH_BLOCKS];
+    static uint64_t packed_tweaks[BENCH_BLOCKS];
+    uint64_t key_hi = BENCH_KEY_HI, key_lo = BENCH_KEY_LO;
+    chilow_strided_t batch = {&records[0].ciphertext, sizeof(record_t), &records[0].tweak,
+                              sizeof(record_t), &key_hi, &key_lo, 0, &records[0].tag,
+                              sizeof(record_t)};
+    double start;
+
+    for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+        records[i].ciphertext = bench_c32[i];
+        records[i].tweak = bench_tweaks[i];
+        records[i].key_hi = BENCH_KEY_HI ^ i;
+        records[i].key_lo = BENCH_KEY_LO;
+    }
+
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_decrypt_32bit_strided(&batch, BENCH_BLOCKS);
+    }
+    report("decrypt_32bit_strided (shared key)", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= records[1].tag;
+
+    /* The same work done by packing into arrays, decrypting and unpacking */
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            packed_c32[i] = records[i].ciphertext;
+            packed_tweaks[i] = records[i].tweak;
+        }
+        chilow_decrypt_32bit_bitsliced(packed_c32, packed_tweaks, key_hi, key_lo, bench_out, BENCH_BLOCKS);
+        for (size_t i = 0; i < BENCH_BLOCKS; i++) {
+            records[i].tag = bench_out[i];
+        }
+    }
+    report("pack + bitsliced + unpack", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= records[1].tag;
+
+    batch.keys_hi = &records[0].key_hi;
+    batch.keys_lo = &records[0].key_lo;
+    batch.key_stride = sizeof(record_t);
+    start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        chilow_decrypt_32bit_strided(&batch, BENCH_BLOCKS);
+    }
+    report("decrypt_32bit_strided (per-record keys)", (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+    bench_sink ^= records[1].tag;
+}
+
+static void bench_bulk(int repeat) {
+    chilow_ctx_t ctx;
+    double single = 0.0;
+    long cores = 1;
+    char name[64];
+
+#ifdef CHILOW_HAVE_PTHREADS
+    cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+#endif
+    chilow_ctx_init(&ctx, BENCH_KEY_HI, BENCH_KEY_LO);
+    printf("  (%ld online cores, %d-block chunks)\n", cores, BULK_CHUNK_BLOCKS);
+
+    /* 1, 2, 4, ... threads, ending at the number of online cores */
+    for (long threads = 1; threads <= cores;
+         threads = (threads < cores && threads * 2 > cores) ? cores : threads * 2) {
+        double start = now_seconds(), elapsed;
+        for (int r = 0; r < repeat; r++) {
+            chilow_decrypt_32bit_bulk(&ctx, bench_c32, bench_tweaks, bench_out, BENCH_BLOCKS, (int)threads);
+        }
+        elapsed = now_seconds() - start;
+        if (threads == 1) single = elapsed;
+        snprintf(name, sizeof name, "chilow_decrypt_32bit_bulk/%ld", threads);
+        report(name, (size_t)repeat * BENCH_BLOCKS, elapsed);
+        printf("    speedup %.2fx\n", single / elapsed);
+        bench_sink ^= bench_out[0];
+
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            chilow_decrypt_40bit_bulk(&ctx, bench_c40, bench_tweaks, bench_out, BENCH_BLOCKS, (int)threads);
+        }
+        snprintf(name, sizeof name, "chilow_decrypt_40bit_bulk/%ld", threads);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0];
+    }
+    chilow_bulk_shutdown();
+}
+
+static void bench_lanes(int repeat) {
+    const size_t batches[] = {8, 64};
+
+    printf("  (%d blocks per vector step)\n", lanes_per_step());
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        char name[64];
+        double start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i += batches[b]) {
+                chilow_decrypt_32bit_lanes(bench_c32 + i, bench_tweaks + i, bench_keys_hi + i,
+                                           bench_keys_lo + i, bench_out + i, batches[b]);
+            }
+        }
+        snprintf(name, sizeof name, "chilow_decrypt_32bit_lanes/%zu", batches[b]);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0];
+
+        start = now_seconds();
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < BENCH_BLOCKS; i += batches[b]) {
+                chilow_decrypt_40bit_lanes(bench_c40 + i, bench_tweaks + i, bench_keys_hi + i,
+                                           bench_keys_lo + i, bench_out + i, batches[b]);
+            }
+        }
+        snprintf(name, sizeof name, "chilow_decrypt_40bit_lanes/%zu", batches[b]);
+        report(name, (size_t)repeat * BENCH_BLOCKS, now_seconds() - start);
+        bench_sink ^= bench_out[0];
+    }
+}
+
+int main(void) {
+    printf("ChiLow Benchmark Suite\n");
+    printf("======================\n\n");
+
+    chilow_init();
+    fill_inputs();
+
+    printf("Scalar decryption and encryption:\n");
+    bench_scalar(4);
+
+    printf("\nReduced-round conventions:\n");
+    bench_round_conventions(2);
+
+    printf("\nRound sweep (all 27 round-count outputs per block):\n");
+    bench_round_sweep(1);
+
+    printf("\nCube enumeration (16 active bits):\n");
+    bench_cube(64);
+
+    printf("\nBitsliced cube sums (8 complete rounds):\n");
+    bench_cube_sum(16);
+
+    printf("\nExpanded-key context decryption:\n");
+    bench_ctx(4);
+
+    printf("\nKey-schedule round (per key update):\n");
+    bench_key_path(4);
+
+#ifdef CHILOW_JIT
+    printf("\nKey-specialized JIT decryption:\n");
+    bench_jit(4);
+#endif
+
+    printf("\nTweak schedule cache decryption:\n");
+    bench_tweak_cache(4);
+
+    printf("\nBitsliced batch decryption:\n");
+    bench_bitsliced(16);
+
+    printf("\nParameterized ChiLow-n engine (bitsliced):\n");
+    bench_engine(8);
+
+    printf("\nTag verification (1 in 16 tags corrupted):\n");
+    bench_verify(8);
+
+    printf("\nMemory encryption (4 KiB pages, address-derived tweaks):\n");
+    bench_memory(4);
+
+    printf("\nPointer authentication (ChiLow-40, per-pointer contexts):\n");
+    bench_pac(4);
+
+    printf("\nCounter-mode PRF keystream:\n");
+    bench_prf(8);
+
+    printf("\nStrided batch decryption (40-byte records):\n");
+    bench_strided(8);
+
+    printf("\nThreaded bulk decryption (threads from 1 to all cores):\n");
+    bench_bulk(16);
+
+    printf("\nLane-parallel decryption (per-block keys):\n");
+    bench_lanes(4);
+
+    return 0;
+}
@@ -26,11 +26,36 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "chilow.h"
+
+/* x86 SIMD kernels are compiled with target attributes and selected at runtime */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CHILOW_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/* Threaded bulk decryption uses a POSIX thread pool where available */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(CHILOW_NO_THREADS)
+#define CHILOW_HAVE_PTHREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef CHILOW_JIT
+/* Key-specialized JIT (POSIX): runtime compilation and dynamic loading */
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 /* ========================================================================== */
 /*                              CONSTANTS & TYPES                            */
 /* ========================================================================== */
 
-#define NUM_ROUNDS 8
+#define NUM_ROUNDS CHILOW_NUM_ROUNDS
 
 /* Bit masks for different sizes */
 static const uint64_t BITMASK_15  = 0x7FFF;
@@ -54,18 +79,52 @@ static const uint64_t ROUND_CONSTANTS_40[NUM_ROUNDS] = {
     0x8000010400000000UL, 0x8000020500000000UL, 0x8000040600000000UL, 0x8000080700000000UL
 };
 
-/* 128-bit integer structure */
-typedef struct {
-    uint64_t lo;  /* Lower 64 bits */
-    uint64_t hi;  /* Upper 64 bits */
-} uint128_t;
-
 /* Linear transformation parameters */
 typedef struct {
     int alpha[3];
     int beta[3];
 } linear_params_t;
 
+/* Linear layer parameters for the different components */
+static const linear_params_t STATE_PARAMS   = {{11, 11, 11}, {5, 9, 12}};
+static const linear_params_t PRF_PARAMS     = {{11, 11, 11}, {1, 26, 30}};
+static const linear_params_t STATE40_PARAMS = {{17, 17, 17}, {1, 9, 30}};
+static const linear_params_t TWEAK_PARAMS   = {{3, 3, 3}, {1, 26, 50}};
+static const linear_params_t KEY_PARAMS     = {{17, 17, 17}, {7, 11, 14}};
+
+/*
+ * Inverse state layers. A factored layer permutes z = x ^ rotr(x, d1) ^ rotr(x, d2) with
+ * d1/d2 = beta[1]/beta[2] - beta[0]. Its inverse first undoes the permutation: bit r reads
+ * bit (alpha * r + beta) % n, where alpha is the forward alpha inverted mod n. It then XORs
+ * rotl(z, s) over the bits s of taps, the inverse of 1 + y^-d1 + y^-d2 in GF(2)[y]/(y^n + 1).
+ * chilow_check_linear_layers() checks both against the inverted matrices.
+ */
+typedef struct {
+    int alpha;
+    int beta;
+    uint64_t taps;
+} linear_inv_params_t;
+
+static const linear_inv_params_t STATE_INV_PARAMS   = {3, 17, 0x066A73DBULL};
+static const linear_inv_params_t STATE40_INV_PARAMS = {33, 7, 0x536E87BD27ULL};
+
+/*
+ * Linear layer as 8x8 bit-matrix blocks for GF2P8AFFINEQB. Each vector packs eight
+ * nonzero blocks, one per 64-bit lane: VPERMB places input byte k at the output byte
+ * position of the block, the affine instruction multiplies it by the block, and all
+ * vectors are XOR-reduced. For the 128-bit layer, even lanes produce output bytes 0-7
+ * and odd lanes bytes 8-15; narrower layers fold all lanes into one 64-bit word.
+ */
+#define CHILOW_GFNI_MAX_VECTORS 32
+
+typedef struct {
+    int width;
+    int num_vectors;
+    uint64_t zero_mask[CHILOW_GFNI_MAX_VECTORS];
+    uint8_t index[CHILOW_GFNI_MAX_VECTORS][64];
+    uint64_t matrix[CHILOW_GFNI_MAX_VECTORS][8];
+} linear_gfni_t;
+
 /* Linear layer matrices (global storage) */
 static uint32_t linear_matrix_32_state[32];
 static uint32_t linear_matrix_32_prf[32];
@@ -73,6 +132,22 @@ static uint64_t linear_matrix_40[40];
 static uint64_t linear_matrix_64[64];
 static uint128_t linear_matrix_128[128];
 
+/* Inverse state layers for the encryption direction */
+static uint32_t linear_matrix_32_state_inv[32];
+static uint64_t linear_matrix_40_inv[40];
+
+/* GFNI linear layers (see linear_gfni_t) */
+static linear_gfni_t linear_gfni_32_state;
+static linear_gfni_t linear_gfni_32_prf;
+static linear_gfni_t linear_gfni_40;
+static linear_gfni_t linear_gfni_64;
+static linear_gfni_t linear_gfni_128;
+
+#ifdef CHILOW_HAVE_X86_SIMD
+/* Set by chilow_init() when the CPU supports the GFNI backend */
+static int linear_use_gfni = 0;
+#endif
+
 /* ========================================================================== */
 /*                              UTILITY FUNCTIONS                            */
 /* ========================================================================== */
@@ -105,17 +180,44 @@ static inline uint64_t rotr64(uint64_t value, int shift, int width) {
  * Basic chi operation: x ⊕ ((¬rot(x,1)) ∧ rot(x,2))
  * This is the core nonlinear transformation in ChiLow
  */
-static uint64_t chi_transform(uint64_t input, uint64_t mask, int bit_width) {
+static inline uint64_t chi_transform(uint64_t input, uint64_t mask, int bit_width) {
     uint64_t rot1 = rotr64(input, 1, bit_width) & mask;
     uint64_t rot2 = rotr64(input, 2, bit_width) & mask;
     return (input ^ ((~rot1) & rot2)) & mask;
 }
 
+/**
+ * Inverse of chi for odd bit widths up to 31 (closed form):
+ * x_i = y_i ^ ~y_{i+1} & (y_{i+2} ^ ~y_{i+3} & (... ^ ~y_{i+n-2} & y_{i+n-1}))
+ * The input is doubled in one word so each rotation is a plain shift; bits above the
+ * width only collect garbage that the final mask removes.
+ */
+static inline uint64_t chi_inverse(uint64_t output, uint64_t mask, int bit_width) {
+    uint64_t doubled = output | (output << bit_width);
+    uint64_t acc = ~(doubled >> (bit_width - 2)) & (doubled >> (bit_width - 1));
+    for (int k = bit_width - 4; k >= 1; k -= 2) {
+        acc = ~(doubled >> k) & ((doubled >> (k + 1)) ^ acc);
+    }
+    return (output ^ acc) & mask;
+}
+
+/**
+ * Linear mixing term of chichi: touches bits split_pos-3 .. split_pos only
+ */
+static inline uint64_t chichi_mix(uint64_t input, int split_pos) {
+    uint64_t linear_mix = 0;
+    linear_mix |= (((input >> split_pos) ^ (input >> (split_pos - 3))) & 1) << (split_pos - 3);
+    linear_mix |= (((input >> (split_pos - 1)) ^ (input >> (split_pos - 2))) & 1) << (split_pos - 2);
+    linear_mix |= (((input >> (split_pos - 3)) ^ (input >> (split_pos - 1)) ^ (input >> split_pos)) & 1) << (split_pos - 1);
+    linear_mix |= (((input >> split_pos) ^ (input >> (split_pos - 2))) & 1) << split_pos;
+    return linear_mix;
+}
+
 /**
  * ChiChi operation for variable-width inputs
  * Splits input into two parts and applies chi to each, with linear mixing
  */
-static uint64_t chichi_transform(uint64_t input, uint64_t small_mask, uint64_t large_mask, int split_pos) {
+static inline uint64_t chichi_transform(uint64_t input, uint64_t small_mask, uint64_t large_mask, int split_pos) {
     /* Split input into lower and upper parts */
     uint64_t lower_part = input & small_mask;
     uint64_t upper_part = (input >> (split_pos - 1)) & large_mask;
@@ -124,22 +226,46 @@ static uint64_t chichi_transform(uint64_t input, uint64_t small_mask, uint64_t l
     uint64_t transformed_lower = chi_transform(lower_part, small_mask, split_pos - 1);
     uint64_t transformed_upper = chi_transform(upper_part, large_mask, split_pos + 1);
     
-    /* Linear mixing layer */
-    uint64_t linear_mix = 0;
-    linear_mix |= (((input >> split_pos) ^ (input >> (split_pos - 3))) & 1) << (split_pos - 3);
-    linear_mix |= (((input >> (split_pos - 1)) ^ (input >> (split_pos - 2))) & 1) << (split_pos - 2);
-    linear_mix |= (((input >> (split_pos - 3)) ^ (input >> (split_pos - 1)) ^ (input >> split_pos)) & 1) << (split_pos - 1);
-    linear_mix |= (((input >> split_pos) ^ (input >> (split_pos - 2))) & 1) << split_pos;
+    /* Combine results with the linear mixing layer */
+    return ((transformed_upper << (split_pos - 1)) | transformed_lower) ^ chichi_mix(input, split_pos);
+}
+
+/**
+ * Inverse of chichi_transform. The mixing term flips the top two bits of the lower
+ * chi and the bottom two bits of the upper chi, depending on those same four input
+ * bits. All four settings of each pair are inverted, and the single consistent
+ * combination is selected without branching (the mixing term is linear, so the check
+ * splits into a lower and an upper half).
+ */
+static inline uint64_t chichi_inverse(uint64_t output, uint64_t small_mask, uint64_t large_mask, int split_pos) {
+    uint64_t lower_out = output & small_mask;
+    uint64_t upper_out = (output >> (split_pos - 1)) & large_mask;
+    uint64_t out_bits = (output >> (split_pos - 3)) & 0xF;
+    uint64_t lower[4], upper[4], lower_check[4], upper_check[4];
+    uint64_t lower_sel = 0, upper_sel = 0;
     
-    /* Combine results */
-    return ((transformed_upper << (split_pos - 1)) | transformed_lower) ^ linear_mix;
+    for (uint64_t v = 0; v < 4; v++) {
+        lower[v] = chi_inverse((lower_out & ~(3ULL << (split_pos - 3))) | (v << (split_pos - 3)), small_mask, split_pos - 1);
+        upper[v] = chi_inverse((upper_out & ~3ULL) | v, large_mask, split_pos + 1) << (split_pos - 1);
+        /* Candidate (a, b) is consistent iff lower_check[a] == upper_check[b] */
+        lower_check[v] = out_bits ^ v ^ (chichi_mix(lower[v] & (3ULL << (split_pos - 3)), split_pos) >> (split_pos - 3));
+        upper_check[v] = (v << 2) ^ (chichi_mix(upper[v] & (3ULL << (split_pos - 1)), split_pos) >> (split_pos - 3));
+    }
+    for (uint64_t a = 0; a < 4; a++) {
+        for (uint64_t b = 0; b < 4; b++) {
+            uint64_t match = (uint64_t)0 - (uint64_t)(lower_check[a] == upper_check[b]);
+            lower_sel |= lower[a] & match;
+            upper_sel |= upper[b] & match;
+        }
+    }
+    return lower_sel | upper_sel;
 }
 
 /**
- * ChiChi operation for 128-bit values
+ * ChiChi operation for 128-bit values on two 64-bit words
  * More complex due to bit width spanning two 64-bit words
  */
-static uint128_t chichi_transform_128(uint128_t input) {
+static inline uint128_t chichi_transform_128_words(uint128_t input) {
     uint128_t result;
     
     /* Extract lower 63 bits and apply chi */
@@ -239,6 +365,33 @@ static void generate_linear_matrix_128(uint128_t* matrix, const linear_params_t*
     }
 }
 
+/**
+ * Invert a linear layer over GF(2) by Gauss-Jordan elimination (width up to 64;
+ * the ChiLow layers are all invertible)
+ */
+static void invert_linear_matrix(const uint64_t* matrix, uint64_t* inverse, int width) {
+    uint64_t rows[64];
+    
+    for (int row = 0; row < width; row++) {
+        rows[row] = matrix[row];
+        inverse[row] = 1ULL << row;
+    }
+    for (int col = 0; col < width; col++) {
+        int pivot = col;
+        while (pivot < width && !((rows[pivot] >> col) & 1)) pivot++;
+        if (pivot == width) continue;
+        
+        uint64_t tmp = rows[col]; rows[col] = rows[pivot]; rows[pivot] = tmp;
+        tmp = inverse[col]; inverse[col] = inverse[pivot]; inverse[pivot] = tmp;
+        for (int row = 0; row < width; row++) {
+            if (row != col && ((rows[row] >> col) & 1)) {
+                rows[row] ^= rows[col];
+                inverse[row] ^= inverse[col];
+            }
+        }
+    }
+}
+
 /**
  * Apply linear transformation using precomputed matrix
  */
@@ -288,416 +441,3917 @@ static uint128_t apply_linear_128(uint128_t input, const uint128_t* matrix) {
     return output;
 }
 
-/* ========================================================================== */
-/*                              INITIALIZATION                               */
-/* ========================================================================== */
-
 /**
- * Initialize all linear transformation matrices
+ * Rotations for the shift/mask linear layers (width up to 64 bits; the input must not
+ * have bits set above the width)
  */
-static void initialize_linear_matrices(void) {
-    /* Parameters for different components */
-    linear_params_t state_params = {{11, 11, 11}, {5, 9, 12}};
-    linear_params_t prf_params = {{11, 11, 11}, {1, 26, 30}};
-    linear_params_t state40_params = {{17, 17, 17}, {1, 9, 30}};
-    linear_params_t tweak_params = {{3, 3, 3}, {1, 26, 50}};
-    linear_params_t key_params = {{17, 17, 17}, {7, 11, 14}};
-    
-    generate_linear_matrix_32(linear_matrix_32_state, &state_params);
-    generate_linear_matrix_32(linear_matrix_32_prf, &prf_params);
-    generate_linear_matrix_40(linear_matrix_40, &state40_params);
-    generate_linear_matrix_64(linear_matrix_64, &tweak_params);
-    generate_linear_matrix_128(linear_matrix_128, &key_params);
+static inline uint64_t rotl_width(uint64_t value, int shift, int width) {
+    if (shift == 0) return value;
+    if (width == 64) return (value << shift) | (value >> (64 - shift));
+    return ((value << shift) | (value >> (width - shift))) & ((1ULL << width) - 1);
 }
 
-/* ========================================================================== */
-/*                              MAIN ALGORITHMS                              */
-/* ========================================================================== */
+static inline uint128_t rotl128(uint128_t value, int shift) {
+    uint128_t result;
+    if (shift >= 64) {
+        uint64_t tmp = value.lo;
+        value.lo = value.hi;
+        value.hi = tmp;
+        shift -= 64;
+    }
+    if (shift == 0) return value;
+    result.lo = (value.lo << shift) | (value.hi >> (64 - shift));
+    result.hi = (value.hi << shift) | (value.lo >> (64 - shift));
+    return result;
+}
 
-/**
- * ChiLow decryption for 32-bit ciphertext
+/*
+ * Compile-time linear layers. Output row r reads z[(alpha*r + beta[0]) % width], so its
+ * rotation amount depends only on r modulo the period p = width / gcd(alpha - 1, width).
+ * Each of the p groups is one rotation and one mask of every p-th row. With constant
+ * params, the loops below fold into immediate rotations and masks, so they need no
+ * tables and no chilow_init().
  */
-static uint64_t chilow_decrypt_32(uint32_t ciphertext, uint64_t tweak, uint128_t key) {
-    /* Initial whitening */
-    uint32_t plaintext = ciphertext ^ (key.hi & BITMASK_32);
-    uint32_t tag = ciphertext ^ ((key.hi >> 32) & BITMASK_32);
-    tweak ^= key.lo;
-    
-    /* Round function iterations */
-    for (int round = 0; round < NUM_ROUNDS - 1; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS[round];
-        
-        /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_32(plaintext, linear_matrix_32_state);
-        tag = apply_linear_32(tag, linear_matrix_32_prf);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
-        tweak ^= key.lo;
+#if defined(__GNUC__)
+#define CONST_INLINE inline __attribute__((always_inline))
+#else
+#define CONST_INLINE inline
+#endif
+
+static CONST_INLINE int linear_const_period(int alpha, int width) {
+    int period = width;
+#if defined(__GNUC__)
+#pragma GCC unroll 128
+#endif
+    for (int p = 1; p < width; p++) {
+        if (((alpha - 1) * p) % width == 0) {
+            period = p;
+            break;
+        }
     }
+    return period;
+}
+
+/* Bit permutation: output bit r is input bit (alpha * r + beta) % width */
+static CONST_INLINE uint64_t linear_const_permute_64(uint64_t input, int alpha, int beta, int width) {
+    int period = linear_const_period(alpha, width);
+    uint64_t output = 0;
     
-    /* Final round (simplified) */
-    plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-    tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-    tweak = apply_linear_64(tweak, linear_matrix_64);
-    plaintext ^= (tweak & BITMASK_32);
-    tag ^= ((tweak >> 32) & BITMASK_32);
+#if defined(__GNUC__)
+#pragma GCC unroll 64
+#endif
+    for (int row = 0; row < period; row++) {
+        int shift = (row - (alpha * row + beta) % width + width) % width;
+        uint64_t mask = 0;
+        for (int r = row; r < width; r += period) mask |= 1ULL << r;
+        output ^= rotl_width(input, shift, width) & mask;
+    }
+    return output;
+}
+
+static CONST_INLINE uint64_t linear_const_64(uint64_t input, const linear_params_t* params, int width) {
+    uint64_t z = input;
     
-    return ((uint64_t)tag << 32) | (plaintext & BITMASK_32);
+    z ^= rotl_width(input, (width - (params->beta[1] - params->beta[0] + width) % width) % width, width);
+    z ^= rotl_width(input, (width - (params->beta[2] - params->beta[0] + width) % width) % width, width);
+    return linear_const_permute_64(z, params->alpha[0], params->beta[0], width);
 }
 
-/**
- * ChiLow decryption with reduced number of rounds
- */
-static uint64_t chilow_decrypt_32_reduced(uint32_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
-    /* Initial whitening */
-    uint32_t plaintext = ciphertext ^ (key.hi & BITMASK_32);
-    uint32_t tag = ciphertext ^ ((key.hi >> 32) & BITMASK_32);
-    tweak ^= key.lo;
+/* Inverse of a factored layer (see linear_inv_params_t) */
+static CONST_INLINE uint64_t linear_const_inv_64(uint64_t input, const linear_inv_params_t* inv, int width) {
+    uint64_t z = linear_const_permute_64(input, inv->alpha, inv->beta, width);
+    uint64_t output = 0;
     
-    /* Round function iterations */
-    for (int round = 0; round < num_rounds - 1; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS[round];
-        
-        /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_32(plaintext, linear_matrix_32_state);
-        tag = apply_linear_32(tag, linear_matrix_32_prf);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
-        tweak ^= key.lo;
+#if defined(__GNUC__)
+#pragma GCC unroll 64
+#endif
+    for (int shift = 0; shift < width; shift++) {
+        if ((inv->taps >> shift) & 1) output ^= rotl_width(z, shift, width);
     }
+    return output;
+}
+
+static CONST_INLINE uint128_t linear_const_128(uint128_t input, const linear_params_t* params) {
+    int period = linear_const_period(params->alpha[0], 128);
+    uint128_t z = input;
+    uint128_t output = {0, 0};
     
-    /* Final round (simplified) if we have at least one round */
-    if (num_rounds > 0) {
-        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
+    for (int k = 1; k < 3; k++) {
+        uint128_t r = rotl128(input, (128 - (params->beta[k] - params->beta[0] + 128) % 128) % 128);
+        z.lo ^= r.lo;
+        z.hi ^= r.hi;
+    }
+#if defined(__GNUC__)
+#pragma GCC unroll 128
+#endif
+    for (int row = 0; row < period; row++) {
+        int shift = (row - (params->alpha[0] * row + params->beta[0]) % 128 + 128) % 128;
+        uint128_t mask = {0, 0};
+        uint128_t r;
+        for (int bit = row; bit < 128; bit += period) {
+            if (bit < 64) {
+                mask.lo |= 1ULL << bit;
+            } else {
+                mask.hi |= 1ULL << (bit - 64);
+            }
+        }
+        r = rotl128(z, shift);
+        output.lo ^= r.lo & mask.lo;
+        output.hi ^= r.hi & mask.hi;
     }
+    return output;
+}
+
+/*
+ * Native 128-bit key path. The key state is one unsigned __int128 (or one SSE2
+ * register), so the 63/65-bit chi halves are masked 128-bit shifts and every group of
+ * the key linear layer is a single whole-register rotation and mask. Bit-exact with the
+ * two-word functions above (see chilow_check_key_paths).
+ */
+#if defined(__SIZEOF_INT128__) && defined(__GNUC__)
+#define CHILOW_HAVE_INT128 1
+__extension__ typedef unsigned __int128 chilow_u128;
+
+static CONST_INLINE chilow_u128 u128_from_words(uint128_t value) {
+    return ((chilow_u128)value.hi << 64) | value.lo;
+}
+
+static CONST_INLINE uint128_t u128_to_words(chilow_u128 value) {
+    uint128_t result = {(uint64_t)value, (uint64_t)(value >> 64)};
+    return result;
+}
+
+static CONST_INLINE chilow_u128 u128_rotl(chilow_u128 value, int shift) {
+    if (shift == 0) return value;
+    return (value << shift) | (value >> (128 - shift));
+}
+
+static CONST_INLINE chilow_u128 u128_chi(chilow_u128 input, chilow_u128 mask, int bit_width) {
+    chilow_u128 rot1 = ((input >> 1) | (input << (bit_width - 1))) & mask;
+    chilow_u128 rot2 = ((input >> 2) | (input << (bit_width - 2))) & mask;
+    return (input ^ (~rot1 & rot2)) & mask;
+}
+
+/**
+ * chichi_transform_128 on one register: chi on bits 0-62 and 63-127, mixing at 61-64
+ */
+static CONST_INLINE chilow_u128 u128_chichi(chilow_u128 input) {
+    const chilow_u128 mask_63 = ((chilow_u128)1 << 63) - 1;
+    const chilow_u128 mask_65 = ((chilow_u128)1 << 65) - 1;
+    chilow_u128 lower = u128_chi(input & mask_63, mask_63, 63);
+    chilow_u128 upper = u128_chi(input >> 63, mask_65, 65);
     
-    return ((uint64_t)tag << 32) | (plaintext & BITMASK_32);
+    /* chichi_mix at split 64, computed on the 64-bit window holding bits 61..64 */
+    uint64_t mix = chichi_mix((uint64_t)(input >> 32), 32);
+    return ((upper << 63) | lower) ^ ((chilow_u128)mix << 32);
 }
 
 /**
- * ChiLow decryption with reduced number of rounds, without final linear layer
+ * linear_const_128 on one register
  */
-static uint64_t chilow_decrypt_32_half_reduced(uint32_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
-    /* Initial whitening */
-    uint32_t plaintext = ciphertext ^ (key.hi & BITMASK_32);
-    uint32_t tag = ciphertext ^ ((key.hi >> 32) & BITMASK_32);
-    tweak ^= key.lo;
+static CONST_INLINE chilow_u128 u128_linear_const(chilow_u128 input, const linear_params_t* params) {
+    int period = linear_const_period(params->alpha[0], 128);
+    chilow_u128 z = input;
+    chilow_u128 output = 0;
     
-    /* Round function iterations */
-    for (int round = 0; round < num_rounds - 1; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS[round];
-        
-        /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_32(plaintext, linear_matrix_32_state);
-        tag = apply_linear_32(tag, linear_matrix_32_prf);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
-        tweak ^= key.lo;
+    z ^= u128_rotl(input, (128 - (params->beta[1] - params->beta[0] + 128) % 128) % 128);
+    z ^= u128_rotl(input, (128 - (params->beta[2] - params->beta[0] + 128) % 128) % 128);
+#if defined(__GNUC__)
+#pragma GCC unroll 128
+#endif
+    for (int row = 0; row < period; row++) {
+        int shift = (row - (params->alpha[0] * row + params->beta[0]) % 128 + 128) % 128;
+        chilow_u128 mask = 0;
+        for (int bit = row; bit < 128; bit += period) mask |= (chilow_u128)1 << bit;
+        output ^= u128_rotl(z, shift) & mask;
     }
+    return output;
+}
+#endif /* __SIZEOF_INT128__ */
+
+#ifdef CHILOW_HAVE_X86_SIMD
+/* SSE2 counterparts: lane 0 holds the low word; cross-lane shifts combine a 64-bit lane
+ * shift with the other lane moved over by a byte shift */
+static CONST_INLINE __m128i sse_shl128(__m128i value, int shift) {
+    if (shift == 0) return value;
+    if (shift >= 64) return _mm_slli_epi64(_mm_slli_si128(value, 8), shift - 64);
+    return _mm_or_si128(_mm_slli_epi64(value, shift), _mm_srli_epi64(_mm_slli_si128(value, 8), 64 - shift));
+}
+
+static CONST_INLINE __m128i sse_shr128(__m128i value, int shift) {
+    if (shift == 0) return value;
+    if (shift >= 64) return _mm_srli_epi64(_mm_srli_si128(value, 8), shift - 64);
+    return _mm_or_si128(_mm_srli_epi64(value, shift), _mm_slli_epi64(_mm_srli_si128(value, 8), 64 - shift));
+}
+
+static CONST_INLINE __m128i sse_rotl128(__m128i value, int shift) {
+    if (shift == 0) return value;
+    return _mm_or_si128(sse_shl128(value, shift), sse_shr128(value, 128 - shift));
+}
+
+static CONST_INLINE __m128i sse_chi(__m128i input, __m128i mask, int bit_width) {
+    __m128i rot1 = _mm_and_si128(_mm_or_si128(sse_shr128(input, 1), sse_shl128(input, bit_width - 1)), mask);
+    __m128i rot2 = _mm_and_si128(_mm_or_si128(sse_shr128(input, 2), sse_shl128(input, bit_width - 2)), mask);
+    return _mm_and_si128(_mm_xor_si128(input, _mm_andnot_si128(rot1, rot2)), mask);
+}
+
+static CONST_INLINE __m128i sse_chichi(__m128i input) {
+    const __m128i mask_63 = _mm_set_epi64x(0, (long long)BITMASK_63);
+    const __m128i mask_65 = _mm_set_epi64x(1, -1);
+    __m128i lower = sse_chi(_mm_and_si128(input, mask_63), mask_63, 63);
+    __m128i upper = sse_chi(sse_shr128(input, 63), mask_65, 65);
     
-    /* Final round without linear layer (only nonlinear + interaction) */
-    if (num_rounds > 0) {
-        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
-        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        /* Skip the linear layer on tweak */
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
-    }
+    /* chichi_mix at split 64, computed on the 64-bit window holding bits 61..64 */
+    uint64_t window = (uint64_t)_mm_cvtsi128_si64(sse_shr128(input, 32));
+    __m128i mix = sse_shl128(_mm_cvtsi64_si128((long long)chichi_mix(window, 32)), 32);
+    return _mm_xor_si128(_mm_or_si128(sse_shl128(upper, 63), lower), mix);
+}
+
+static CONST_INLINE __m128i sse_linear_const(__m128i input, const linear_params_t* params) {
+    int period = linear_const_period(params->alpha[0], 128);
+    __m128i z = input;
+    __m128i output = _mm_setzero_si128();
     
-    return ((uint64_t)tag << 32) | (plaintext & BITMASK_32);
+    z = _mm_xor_si128(z, sse_rotl128(input, (128 - (params->beta[1] - params->beta[0] + 128) % 128) % 128));
+    z = _mm_xor_si128(z, sse_rotl128(input, (128 - (params->beta[2] - params->beta[0] + 128) % 128) % 128));
+#if defined(__GNUC__)
+#pragma GCC unroll 128
+#endif
+    for (int row = 0; row < period; row++) {
+        int shift = (row - (params->alpha[0] * row + params->beta[0]) % 128 + 128) % 128;
+        uint64_t mask_lo = 0, mask_hi = 0;
+        for (int bit = row; bit < 128; bit += period) {
+            if (bit < 64) {
+                mask_lo |= 1ULL << bit;
+            } else {
+                mask_hi |= 1ULL << (bit - 64);
+            }
+        }
+        output = _mm_xor_si128(output, _mm_and_si128(sse_rotl128(z, shift),
+                                                      _mm_set_epi64x((long long)mask_hi, (long long)mask_lo)));
+    }
+    return output;
 }
+#endif /* CHILOW_HAVE_X86_SIMD */
 
 /**
- * ChiLow decryption for 40-bit ciphertext
+ * Split a linear layer into 8x8 blocks for GFNI
  */
-static uint64_t chilow_decrypt_40(uint64_t ciphertext, uint64_t tweak, uint128_t key) {
-    /* Initial whitening */
-    uint64_t plaintext = ciphertext ^ (key.hi & BITMASK_40);
-    tweak ^= key.lo;
+static void generate_linear_gfni(linear_gfni_t* gfni, const linear_params_t* params, int width) {
+    uint128_t rows[128];
+    int bytes = width / 8;
+    int next_lane[2] = {0, 1};
+    int stride = (width == 128) ? 2 : 1;
     
-    /* Round function iterations */
-    for (int round = 0; round < NUM_ROUNDS - 1; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS_40[round];
-        
-        /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_40(plaintext, linear_matrix_40);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_40);
-        tweak ^= key.lo;
+    for (int row = 0; row < width; row++) {
+        rows[row].lo = 0;
+        rows[row].hi = 0;
+        for (int term = 0; term < 3; term++) {
+            int col = (params->alpha[term] * row + params->beta[term]) % width;
+            if (col < 64) {
+                rows[row].lo ^= 1ULL << col;
+            } else {
+                rows[row].hi ^= 1ULL << (col - 64);
+            }
+        }
     }
     
-    /* Final round (simplified) */
-    plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
-    tweak = apply_linear_64(tweak, linear_matrix_64);
-    plaintext = (plaintext ^ (tweak & BITMASK_40)) & BITMASK_40;
+    memset(gfni, 0, sizeof(*gfni));
+    gfni->width = width;
     
-    return plaintext;
+    for (int out_byte = 0; out_byte < bytes; out_byte++) {
+        int half = (width == 128) ? out_byte / 8 : 0;
+        for (int in_byte = 0; in_byte < bytes; in_byte++) {
+            uint64_t block = 0;
+            for (int i = 0; i < 8; i++) {
+                const uint128_t* row = &rows[8 * out_byte + i];
+                uint64_t word = (in_byte < 8) ? row->lo : row->hi;
+                /* GF2P8AFFINEQB takes the row for output bit i from matrix byte 7 - i */
+                block |= ((word >> (8 * (in_byte % 8))) & 0xFF) << (8 * (7 - i));
+            }
+            if (block == 0) continue;
+            
+            int slot = next_lane[half];
+            int vec = slot / 8, lane = slot % 8;
+            int pos = 8 * lane + out_byte % 8;
+            next_lane[half] += stride;
+            gfni->matrix[vec][lane] = block;
+            gfni->index[vec][pos] = (uint8_t)in_byte;
+            gfni->zero_mask[vec] |= 1ULL << pos;
+            if (vec + 1 > gfni->num_vectors) gfni->num_vectors = vec + 1;
+        }
+    }
 }
 
+#ifdef CHILOW_HAVE_X86_SIMD
+#define GFNI_TARGET __attribute__((target("avx512f,avx512bw,avx512vbmi,gfni")))
+
 /**
- * ChiLow decryption for 40-bit ciphertext with reduced number of rounds
+ * Apply a linear layer with GF2P8AFFINEQB (see linear_gfni_t)
  */
-static uint64_t chilow_decrypt_40_reduced(uint64_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
-    /* Initial whitening */
-    uint64_t plaintext = ciphertext ^ (key.hi & BITMASK_40);
-    tweak ^= key.lo;
+static GFNI_TARGET uint128_t apply_linear_gfni(uint128_t input, const linear_gfni_t* gfni) {
+    __m512i x = _mm512_zextsi128_si512(_mm_set_epi64x((long long)input.hi, (long long)input.lo));
+    __m512i acc = _mm512_setzero_si512();
+    uint128_t output;
     
-    /* Round function iterations */
-    for (int round = 0; round < num_rounds - 1; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS_40[round];
-        
-        /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_40(plaintext, linear_matrix_40);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_40);
-        tweak ^= key.lo;
+    for (int v = 0; v < gfni->num_vectors; v++) {
+        __m512i index = _mm512_loadu_si512(gfni->index[v]);
+        __m512i matrix = _mm512_loadu_si512(gfni->matrix[v]);
+        __m512i gathered = _mm512_maskz_permutexvar_epi8(gfni->zero_mask[v], index, x);
+        acc = _mm512_xor_si512(acc, _mm512_gf2p8affine_epi64_epi8(gathered, matrix, 0));
     }
     
-    /* Final round (simplified) if we have at least one round */
-    if (num_rounds > 0) {
-        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        plaintext = (plaintext ^ (tweak & BITMASK_40)) & BITMASK_40;
+    __m256i acc256 = _mm256_xor_si256(_mm512_castsi512_si256(acc), _mm512_extracti64x4_epi64(acc, 1));
+    __m128i acc128 = _mm_xor_si128(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+    output.lo = (uint64_t)_mm_cvtsi128_si64(acc128);
+    output.hi = (uint64_t)_mm_extract_epi64(acc128, 1);
+    if (gfni->width < 128) {
+        output.lo ^= output.hi;
+        output.hi = 0;
     }
-    
-    return plaintext;
+    return output;
+}
+
+static inline uint64_t apply_linear_gfni_64(uint64_t input, const linear_gfni_t* gfni) {
+    uint128_t wide = {input, 0};
+    return apply_linear_gfni(wide, gfni).lo;
 }
 
 /**
- * ChiLow decryption for 40-bit ciphertext with reduced number of rounds, without final linear layer
+ * Check for the instructions used by apply_linear_gfni
  */
-static uint64_t chilow_decrypt_40_half_reduced(uint64_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
-    /* Initial whitening */
-    uint64_t plaintext = ciphertext ^ (key.hi & BITMASK_40);
+static int cpu_has_gfni_backend(void) {
+    return __builtin_cpu_supports("gfni") && __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+}
+#endif /* CHILOW_HAVE_X86_SIMD */
+
+/**
+ * Linear layers used by the round engine: compile-time shift/mask layers by default.
+ * Define CHILOW_LINEAR_MATRIX for the reference popcount matrices, or CHILOW_LINEAR_GFNI
+ * for the GFNI backend when chilow_init() detects it (both need chilow_init()).
+ */
+static inline uint32_t linear_layer_state_32(uint32_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_32(input, linear_matrix_32_state);
+#else
+#if defined(CHILOW_LINEAR_GFNI) && defined(CHILOW_HAVE_X86_SIMD)
+    if (linear_use_gfni) return (uint32_t)apply_linear_gfni_64(input, &linear_gfni_32_state);
+#endif
+    return (uint32_t)linear_const_64(input, &STATE_PARAMS, 32);
+#endif
+}
+
+static inline uint32_t linear_layer_prf_32(uint32_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_32(input, linear_matrix_32_prf);
+#else
+#if defined(CHILOW_LINEAR_GFNI) && defined(CHILOW_HAVE_X86_SIMD)
+    if (linear_use_gfni) return (uint32_t)apply_linear_gfni_64(input, &linear_gfni_32_prf);
+#endif
+    return (uint32_t)linear_const_64(input, &PRF_PARAMS, 32);
+#endif
+}
+
+static inline uint64_t linear_layer_state_40(uint64_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_40(input, linear_matrix_40);
+#else
+#if defined(CHILOW_LINEAR_GFNI) && defined(CHILOW_HAVE_X86_SIMD)
+    if (linear_use_gfni) return apply_linear_gfni_64(input & BITMASK_40, &linear_gfni_40);
+#endif
+    return linear_const_64(input & BITMASK_40, &STATE40_PARAMS, 40);
+#endif
+}
+
+static inline uint64_t linear_layer_tweak_64(uint64_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_64(input, linear_matrix_64);
+#else
+#if defined(CHILOW_LINEAR_GFNI) && defined(CHILOW_HAVE_X86_SIMD)
+    if (linear_use_gfni) return apply_linear_gfni_64(input, &linear_gfni_64);
+#endif
+    return linear_const_64(input, &TWEAK_PARAMS, 64);
+#endif
+}
+
+static inline uint128_t linear_layer_key_128(uint128_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_128(input, linear_matrix_128);
+#else
+#if defined(CHILOW_LINEAR_GFNI) && defined(CHILOW_HAVE_X86_SIMD)
+    if (linear_use_gfni) return apply_linear_gfni(input, &linear_gfni_128);
+#endif
+#if defined(CHILOW_KEY_PATH_SSE) && defined(CHILOW_HAVE_X86_SIMD)
+    __m128i value = _mm_set_epi64x((long long)input.hi, (long long)input.lo);
+    value = sse_linear_const(value, &KEY_PARAMS);
+    input.lo = (uint64_t)_mm_cvtsi128_si64(value);
+    input.hi = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value));
+    return input;
+#elif defined(CHILOW_KEY_PATH_INT128) && defined(CHILOW_HAVE_INT128)
+    return u128_to_words(u128_linear_const(u128_from_words(input), &KEY_PARAMS));
+#else
+    return linear_const_128(input, &KEY_PARAMS);
+#endif
+#endif
+}
+
+/**
+ * Key-path nonlinear layer. Define CHILOW_KEY_PATH_INT128 or CHILOW_KEY_PATH_SSE to run
+ * both key layers on unsigned __int128 or __m128i; the two-word path stays the default
+ * since neither measured faster per key update (see bench_key_path)
+ */
+static inline uint128_t chichi_transform_128(uint128_t input) {
+#if defined(CHILOW_KEY_PATH_SSE) && defined(CHILOW_HAVE_X86_SIMD)
+    __m128i value = _mm_set_epi64x((long long)input.hi, (long long)input.lo);
+    value = sse_chichi(value);
+    input.lo = (uint64_t)_mm_cvtsi128_si64(value);
+    input.hi = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value));
+    return input;
+#elif defined(CHILOW_KEY_PATH_INT128) && defined(CHILOW_HAVE_INT128)
+    return u128_to_words(u128_chichi(u128_from_words(input)));
+#else
+    return chichi_transform_128_words(input);
+#endif
+}
+
+#define CHILOW_KEY_PATH_CHECKS 1024
+
+/*
+ * One key-schedule round (round constant, chichi, linear layer) per key-path
+ * implementation, for chilow_check_key_paths() and the benchmarks
+ */
+static uint128_t key_round_words(uint128_t key, uint64_t constant) {
+    key.hi ^= constant;
+    return linear_const_128(chichi_transform_128_words(key), &KEY_PARAMS);
+}
+
+#ifdef CHILOW_HAVE_INT128
+static uint128_t key_round_int128(uint128_t key, uint64_t constant) {
+    chilow_u128 value = u128_from_words(key) ^ ((chilow_u128)constant << 64);
+    return u128_to_words(u128_linear_const(u128_chichi(value), &KEY_PARAMS));
+}
+#endif
+
+#ifdef CHILOW_HAVE_X86_SIMD
+static uint128_t key_round_sse(uint128_t key, uint64_t constant) {
+    __m128i value = _mm_set_epi64x((long long)(key.hi ^ constant), (long long)key.lo);
+    uint128_t result;
+    value = sse_linear_const(sse_chichi(value), &KEY_PARAMS);
+    result.lo = (uint64_t)_mm_cvtsi128_si64(value);
+    result.hi = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value));
+    return result;
+}
+#endif
+
+/**
+ * Inverse state layers (encryption direction): compile-time like the forward layers,
+ * or the inverted reference matrices under CHILOW_LINEAR_MATRIX (needs chilow_init())
+ */
+static inline uint32_t linear_layer_state_32_inv(uint32_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_32(input, linear_matrix_32_state_inv);
+#else
+    return (uint32_t)linear_const_inv_64(input, &STATE_INV_PARAMS, 32);
+#endif
+}
+
+static inline uint64_t linear_layer_state_40_inv(uint64_t input) {
+#ifdef CHILOW_LINEAR_MATRIX
+    return apply_linear_40(input, linear_matrix_40_inv);
+#else
+    return linear_const_inv_64(input & BITMASK_40, &STATE40_INV_PARAMS, 40);
+#endif
+}
+
+/* ========================================================================== */
+/*                              INITIALIZATION                               */
+/* ========================================================================== */
+
+/**
+ * Initialize all linear transformation matrices
+ */
+static void initialize_linear_matrices(void) {
+    uint64_t rows[64], inverse[64];
+    
+    generate_linear_matrix_32(linear_matrix_32_state, &STATE_PARAMS);
+    generate_linear_matrix_32(linear_matrix_32_prf, &PRF_PARAMS);
+    generate_linear_matrix_40(linear_matrix_40, &STATE40_PARAMS);
+    generate_linear_matrix_64(linear_matrix_64, &TWEAK_PARAMS);
+    generate_linear_matrix_128(linear_matrix_128, &KEY_PARAMS);
+    
+    /* Inverse state layers for encryption */
+    for (int row = 0; row < 32; row++) rows[row] = linear_matrix_32_state[row];
+    invert_linear_matrix(rows, inverse, 32);
+    for (int row = 0; row < 32; row++) linear_matrix_32_state_inv[row] = (uint32_t)inverse[row];
+    invert_linear_matrix(linear_matrix_40, linear_matrix_40_inv, 40);
+    
+    generate_linear_gfni(&linear_gfni_32_state, &STATE_PARAMS, 32);
+    generate_linear_gfni(&linear_gfni_32_prf, &PRF_PARAMS, 32);
+    generate_linear_gfni(&linear_gfni_40, &STATE40_PARAMS, 40);
+    generate_linear_gfni(&linear_gfni_64, &TWEAK_PARAMS, 64);
+    generate_linear_gfni(&linear_gfni_128, &KEY_PARAMS, 128);
+    
+#ifdef CHILOW_HAVE_X86_SIMD
+    linear_use_gfni = cpu_has_gfni_backend();
+#endif
+}
+
+/* ========================================================================== */
+/*                              MAIN ALGORITHMS                              */
+/* ========================================================================== */
+
+/* Final round conventions for the round engines */
+#define FINAL_ROUND_NONE 0  /* complete rounds only */
+#define FINAL_ROUND_FULL 1  /* nonlinear layer, tweak linear layer, interaction */
+#define FINAL_ROUND_HALF 2  /* nonlinear layer and interaction, no linear layer */
+
+/**
+ * Record one captured state (see chilow_trace_t)
+ */
+static CONST_INLINE void trace_state(chilow_state_t* state, uint64_t plaintext, uint64_t tag,
+                                     uint64_t tweak, uint128_t key) {
+    state->plaintext = plaintext;
+    state->tag = tag;
+    state->tweak = tweak;
+    state->key_hi = key.hi;
+    state->key_lo = key.lo;
+}
+
+/**
+ * Clamp a requested round count to the rounds covered by the key schedule
+ */
+static inline int clamp_rounds(int num_rounds) {
+    if (num_rounds < 0) return 0;
+    return (num_rounds > NUM_ROUNDS) ? NUM_ROUNDS : num_rounds;
+}
+
+/**
+ * Record the whitened state, the output of round count 0 under all three conventions
+ */
+static CONST_INLINE void sweep_whitening(chilow_round_sweep_t* sweep, uint64_t output) {
+    sweep->reduced[0] = output;
+    sweep->half_reduced[0] = output;
+    sweep->complete[0] = output;
+}
+
+/**
+ * Record the final-round branches of round count r + 1 (see chilow_round_sweep_t), from
+ * the state after r full rounds with the nonlinear layer of round r already applied to
+ * the plaintext and tag; tweak has not entered round r yet
+ */
+static CONST_INLINE void sweep_branch_32(chilow_round_sweep_t* sweep, int rounds, uint32_t plaintext,
+                                         uint32_t tag, uint64_t tweak) {
+    uint64_t final_tweak = linear_layer_tweak_64(tweak);
+    sweep->half_reduced[rounds] = ((uint64_t)(tag ^ (uint32_t)(tweak >> 32)) << 32) |
+                                  (plaintext ^ (uint32_t)tweak);
+    sweep->reduced[rounds] = ((uint64_t)(tag ^ (uint32_t)(final_tweak >> 32)) << 32) |
+                             (plaintext ^ (uint32_t)final_tweak);
+}
+
+static CONST_INLINE void sweep_branch_40(chilow_round_sweep_t* sweep, int rounds, uint64_t plaintext,
+                                         uint64_t tweak) {
+    sweep->half_reduced[rounds] = (plaintext ^ tweak) & BITMASK_40;
+    sweep->reduced[rounds] = (plaintext ^ linear_layer_tweak_64(tweak)) & BITMASK_40;
+}
+
+/**
+ * ChiLow decryption for 32-bit ciphertext: full_rounds complete rounds followed by the
+ * given final round convention. The key path runs alongside the rounds unless
+ * round_keys holds its precomputed output (see chilow_ctx_t). A non-NULL trace receives
+ * the state after every layer, and a non-NULL sweep the output of every round count (see
+ * sweep_decrypt_32); both are a constant NULL in every specialization except their entry
+ * points, so the capture code is dropped from the normal path. Only called
+ * with constant round counts and conventions (see ENGINE_DEFINE), so every specialization
+ * is fully unrolled.
+ */
+static CONST_INLINE uint64_t engine_decrypt_32(uint32_t ciphertext, uint64_t tweak, uint128_t key,
+                                               const uint64_t* round_keys, int full_rounds, int final_round,
+                                               chilow_trace_t* trace, chilow_round_sweep_t* sweep) {
+    /* Initial whitening */
+    uint32_t plaintext = ciphertext ^ (key.hi & BITMASK_32);
+    uint32_t tag = ciphertext ^ ((key.hi >> 32) & BITMASK_32);
     tweak ^= key.lo;
+    if (trace != NULL) trace_state(&trace->whitening, plaintext, tag, tweak, key);
+    if (sweep != NULL) sweep_whitening(sweep, ((uint64_t)tag << 32) | plaintext);
     
     /* Round function iterations */
-    for (int round = 0; round < num_rounds - 1; round++) {
+#if defined(__GNUC__)
+#pragma GCC unroll 8
+#endif
+    for (int round = 0; round < full_rounds; round++) {
         /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS_40[round];
+        if (round_keys == NULL) key.hi ^= ROUND_CONSTANTS[round];
         
         /* Nonlinear layer */
-        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
+        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
+        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
+        if (sweep != NULL) sweep_branch_32(sweep, round + 1, plaintext, tag, tweak);
         tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
+        if (round_keys == NULL) key = chichi_transform_128(key);
+        if (trace != NULL) trace_state(&trace->rounds[round].nonlinear, plaintext, tag, tweak, key);
         
         /* Linear layer */
-        plaintext = apply_linear_40(plaintext, linear_matrix_40);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
+        plaintext = linear_layer_state_32(plaintext);
+        tag = linear_layer_prf_32(tag);
+        tweak = linear_layer_tweak_64(tweak);
+        if (round_keys == NULL) key = linear_layer_key_128(key);
+        if (trace != NULL) trace_state(&trace->rounds[round].linear, plaintext, tag, tweak, key);
         
         /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_40);
-        tweak ^= key.lo;
+        plaintext ^= (tweak & BITMASK_32);
+        tag ^= ((tweak >> 32) & BITMASK_32);
+        tweak ^= (round_keys == NULL) ? key.lo : round_keys[round];
+        if (trace != NULL) trace_state(&trace->rounds[round].interaction, plaintext, tag, tweak, key);
+        if (sweep != NULL) sweep->complete[round + 1] = ((uint64_t)tag << 32) | plaintext;
     }
     
-    /* Final round without linear layer (only nonlinear + interaction) */
-    if (num_rounds > 0) {
-        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
-        /* Skip the linear layer on tweak */
-        plaintext = (plaintext ^ (tweak & BITMASK_40)) & BITMASK_40;
+    /* Final round (simplified), with or without the tweak linear layer */
+    if (final_round != FINAL_ROUND_NONE) {
+        plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
+        tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].nonlinear, plaintext, tag, tweak, key);
+        if (final_round == FINAL_ROUND_FULL) {
+            tweak = linear_layer_tweak_64(tweak);
+        }
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].linear, plaintext, tag, tweak, key);
+        plaintext ^= (tweak & BITMASK_32);
+        tag ^= ((tweak >> 32) & BITMASK_32);
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].interaction, plaintext, tag, tweak, key);
     }
     
-    return plaintext;
+    return ((uint64_t)tag << 32) | (plaintext & BITMASK_32);
 }
 
 /**
- * ChiLow decryption for 40-bit ciphertext with exactly num_rounds complete rounds
- * (for integral cryptanalysis - performs exactly num_rounds complete rounds)
+ * ChiLow decryption for 40-bit ciphertext (same conventions as engine_decrypt_32)
  */
-static uint64_t chilow_decrypt_40_complete_rounds(uint64_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
+static CONST_INLINE uint64_t engine_decrypt_40(uint64_t ciphertext, uint64_t tweak, uint128_t key,
+                                               const uint64_t* round_keys, int full_rounds, int final_round,
+                                               chilow_trace_t* trace, chilow_round_sweep_t* sweep) {
     /* Initial whitening */
     uint64_t plaintext = ciphertext ^ (key.hi & BITMASK_40);
     tweak ^= key.lo;
+    if (trace != NULL) trace_state(&trace->whitening, plaintext, 0, tweak, key);
+    if (sweep != NULL) sweep_whitening(sweep, plaintext & BITMASK_40);
     
-    /* Complete round function iterations */
-    for (int round = 0; round < num_rounds; round++) {
+    /* Round function iterations */
+#if defined(__GNUC__)
+#pragma GCC unroll 8
+#endif
+    for (int round = 0; round < full_rounds; round++) {
         /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS_40[round];
+        if (round_keys == NULL) key.hi ^= ROUND_CONSTANTS_40[round];
         
         /* Nonlinear layer */
         plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
+        if (sweep != NULL) sweep_branch_40(sweep, round + 1, plaintext, tweak);
         tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
+        if (round_keys == NULL) key = chichi_transform_128(key);
+        if (trace != NULL) trace_state(&trace->rounds[round].nonlinear, plaintext, 0, tweak, key);
         
         /* Linear layer */
-        plaintext = apply_linear_40(plaintext, linear_matrix_40);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
+        plaintext = linear_layer_state_40(plaintext);
+        tweak = linear_layer_tweak_64(tweak);
+        if (round_keys == NULL) key = linear_layer_key_128(key);
+        if (trace != NULL) trace_state(&trace->rounds[round].linear, plaintext, 0, tweak, key);
         
         /* Interaction layer */
         plaintext ^= (tweak & BITMASK_40);
-        tweak ^= key.lo;
+        tweak ^= (round_keys == NULL) ? key.lo : round_keys[round];
+        if (trace != NULL) trace_state(&trace->rounds[round].interaction, plaintext, 0, tweak, key);
+        if (sweep != NULL) sweep->complete[round + 1] = plaintext & BITMASK_40;
+    }
+    
+    /* Final round (simplified), with or without the tweak linear layer */
+    if (final_round != FINAL_ROUND_NONE) {
+        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].nonlinear, plaintext, 0, tweak, key);
+        if (final_round == FINAL_ROUND_FULL) {
+            tweak = linear_layer_tweak_64(tweak);
+        }
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].linear, plaintext, 0, tweak, key);
+        plaintext ^= (tweak & BITMASK_40);
+        if (trace != NULL) trace_state(&trace->rounds[full_rounds].interaction, plaintext, 0, tweak, key);
     }
     
     return plaintext & BITMASK_40;
 }
 
+/*
+ * One specialization per (variant, full rounds, final round convention), named
+ * engine_<variant>_<convention>_<full rounds> (key path computed on the fly) and
+ * ctx_engine_<variant>_<convention>_<full rounds> (expanded key), collected into
+ * dispatch tables indexed by the public round count.
+ */
+typedef uint64_t (*engine_32_fn)(uint32_t ciphertext, uint64_t tweak, uint128_t key);
+typedef uint64_t (*engine_40_fn)(uint64_t ciphertext, uint64_t tweak, uint128_t key);
+typedef uint64_t (*ctx_engine_32_fn)(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak);
+typedef uint64_t (*ctx_engine_40_fn)(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak);
+
+#define ENGINE_DEFINE(ROUNDS, FINAL, SUFFIX)                                                    \
+static uint64_t engine_32_##SUFFIX##_##ROUNDS(uint32_t ciphertext, uint64_t tweak, uint128_t key) { \
+    return engine_decrypt_32(ciphertext, tweak, key, NULL, ROUNDS, FINAL, NULL, NULL);          \
+}                                                                                               \
+static uint64_t engine_40_##SUFFIX##_##ROUNDS(uint64_t ciphertext, uint64_t tweak, uint128_t key) { \
+    return engine_decrypt_40(ciphertext, tweak, key, NULL, ROUNDS, FINAL, NULL, NULL);          \
+}                                                                                               \
+static uint64_t ctx_engine_32_##SUFFIX##_##ROUNDS(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak) { \
+    uint128_t key = {ctx->key_lo, ctx->key_hi};                                                 \
+    return engine_decrypt_32(ciphertext, tweak, key, ctx->round_keys_32, ROUNDS, FINAL, NULL, NULL); \
+}                                                                                               \
+static uint64_t ctx_engine_40_##SUFFIX##_##ROUNDS(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak) { \
+    uint128_t key = {ctx->key_lo, ctx->key_hi};                                                 \
+    return engine_decrypt_40(ciphertext, tweak, key, ctx->round_keys_40, ROUNDS, FINAL, NULL, NULL); \
+}
+
+#define ENGINE_FOR_ROUNDS_0_7(X, FINAL, SUFFIX)                                                 \
+    X(0, FINAL, SUFFIX) X(1, FINAL, SUFFIX) X(2, FINAL, SUFFIX) X(3, FINAL, SUFFIX)             \
+    X(4, FINAL, SUFFIX) X(5, FINAL, SUFFIX) X(6, FINAL, SUFFIX) X(7, FINAL, SUFFIX)
+
+ENGINE_FOR_ROUNDS_0_7(ENGINE_DEFINE, FINAL_ROUND_NONE, none)
+ENGINE_DEFINE(8, FINAL_ROUND_NONE, none)
+ENGINE_FOR_ROUNDS_0_7(ENGINE_DEFINE, FINAL_ROUND_FULL, full)
+ENGINE_FOR_ROUNDS_0_7(ENGINE_DEFINE, FINAL_ROUND_HALF, half)
+
+#define ENGINE_TABLE(PREFIX, SUFFIX)                                                            \
+    { PREFIX##_none_0, PREFIX##_##SUFFIX##_0, PREFIX##_##SUFFIX##_1, PREFIX##_##SUFFIX##_2,     \
+      PREFIX##_##SUFFIX##_3, PREFIX##_##SUFFIX##_4, PREFIX##_##SUFFIX##_5, PREFIX##_##SUFFIX##_6, \
+      PREFIX##_##SUFFIX##_7 }
+
+#define ENGINE_TABLE_COMPLETE(PREFIX)                                                           \
+    { PREFIX##_none_0, PREFIX##_none_1, PREFIX##_none_2, PREFIX##_none_3, PREFIX##_none_4,      \
+      PREFIX##_none_5, PREFIX##_none_6, PREFIX##_none_7, PREFIX##_none_8 }
+
+/* Indexed by num_rounds in [0, 8]: reduced = r-1 rounds + final round, complete = r rounds */
+static const engine_32_fn ENGINE_32_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(engine_32, full);
+static const engine_32_fn ENGINE_32_HALF_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(engine_32, half);
+static const engine_32_fn ENGINE_32_COMPLETE[NUM_ROUNDS + 1] = ENGINE_TABLE_COMPLETE(engine_32);
+static const engine_40_fn ENGINE_40_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(engine_40, full);
+static const engine_40_fn ENGINE_40_HALF_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(engine_40, half);
+static const engine_40_fn ENGINE_40_COMPLETE[NUM_ROUNDS + 1] = ENGINE_TABLE_COMPLETE(engine_40);
+static const ctx_engine_32_fn CTX_ENGINE_32_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(ctx_engine_32, full);
+static const ctx_engine_32_fn CTX_ENGINE_32_HALF_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(ctx_engine_32, half);
+static const ctx_engine_32_fn CTX_ENGINE_32_COMPLETE[NUM_ROUNDS + 1] = ENGINE_TABLE_COMPLETE(ctx_engine_32);
+static const ctx_engine_40_fn CTX_ENGINE_40_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(ctx_engine_40, full);
+static const ctx_engine_40_fn CTX_ENGINE_40_HALF_REDUCED[NUM_ROUNDS + 1] = ENGINE_TABLE(ctx_engine_40, half);
+static const ctx_engine_40_fn CTX_ENGINE_40_COMPLETE[NUM_ROUNDS + 1] = ENGINE_TABLE_COMPLETE(ctx_engine_40);
+
+/**
+ * Round sweep for 32-bit ciphertext: one pass of the round engine over the full rounds
+ * that records the output of every round count under all three conventions (indices as
+ * in the dispatch tables above). The final round of reduced[r + 1] / half_reduced[r + 1]
+ * branches off the state after r full rounds and shares the nonlinear layer of round r.
+ */
+static void sweep_decrypt_32(uint32_t ciphertext, uint64_t tweak, uint128_t key,
+                             const uint64_t* round_keys, chilow_round_sweep_t* sweep) {
+    engine_decrypt_32(ciphertext, tweak, key, round_keys, NUM_ROUNDS, FINAL_ROUND_NONE, NULL, sweep);
+}
+
 /**
- * ChiLow decryption with exactly num_rounds complete rounds (for integral cryptanalysis)
- * This function performs exactly 'num_rounds' complete rounds without any special final round
+ * Round sweep for 40-bit ciphertext (same layout as sweep_decrypt_32)
  */
-static uint64_t chilow_decrypt_32_complete_rounds(uint32_t ciphertext, uint64_t tweak, uint128_t key, int num_rounds) {
-    /* Initial whitening */
-    uint32_t plaintext = ciphertext ^ (key.hi & BITMASK_32);
-    uint32_t tag = ciphertext ^ ((key.hi >> 32) & BITMASK_32);
-    tweak ^= key.lo;
+static void sweep_decrypt_40(uint64_t ciphertext, uint64_t tweak, uint128_t key,
+                             const uint64_t* round_keys, chilow_round_sweep_t* sweep) {
+    engine_decrypt_40(ciphertext, tweak, key, round_keys, NUM_ROUNDS, FINAL_ROUND_NONE, NULL, sweep);
+}
+
+/* ========================================================================== */
+/*                              EXPANDED-KEY CONTEXT                         */
+/* ========================================================================== */
+
+/**
+ * Compute the key injected into the tweak after each full round
+ * (the key path does not depend on the ciphertext or tweak)
+ */
+static void expand_round_keys(uint128_t key, const uint64_t* constants, int num_rounds, uint64_t* round_keys) {
+    for (int round = 0; round < num_rounds; round++) {
+        key.hi ^= constants[round];
+        key = chichi_transform_128(key);
+        key = linear_layer_key_128(key);
+        round_keys[round] = key.lo;
+    }
+}
+
+/* ========================================================================== */
+/*                              TWEAK SCHEDULE CACHE                         */
+/* ========================================================================== */
+
+/*
+ * For a fixed key and tweak, the tweak path produces the same word before every
+ * interaction layer: masks[r] for full round r < NUM_ROUNDS - 1 and masks[NUM_ROUNDS - 1]
+ * for the final round. A cache hit replays those masks and only runs the state/tag path.
+ */
+
+#define TWEAK_CACHE_VARIANT_32 1
+#define TWEAK_CACHE_VARIANT_40 2
+
+/**
+ * Run the tweak path of num_rounds full rounds, recording the word entering the
+ * interaction layer of each round; returns the tweak after the last round key
+ */
+static uint64_t tweak_round_masks(uint64_t key_lo, uint64_t tweak, const uint64_t* round_keys,
+                                  int num_rounds, uint64_t* masks) {
+    tweak ^= key_lo;
+    for (int round = 0; round < num_rounds; round++) {
+        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
+        tweak = linear_layer_tweak_64(tweak);
+        masks[round] = tweak;
+        tweak ^= round_keys[round];
+    }
+    return tweak;
+}
+
+/**
+ * Run the tweak path of a full decryption and record the interaction masks
+ */
+static void tweak_schedule(uint64_t key_lo, uint64_t tweak, const uint64_t* round_keys, uint64_t* masks) {
+    tweak = tweak_round_masks(key_lo, tweak, round_keys, NUM_ROUNDS - 1, masks);
+    masks[NUM_ROUNDS - 1] = linear_layer_tweak_64(tweak);
+}
+
+/**
+ * State and tag paths of num_rounds complete rounds with precomputed tweak masks
+ * (tweak_round_masks); outputs[r], if given, receives the output after r rounds
+ */
+static inline uint64_t masked_complete_rounds_32(uint64_t key_hi, uint32_t ciphertext, const uint64_t* masks,
+                                                 int num_rounds, uint64_t* outputs) {
+    uint32_t plaintext = ciphertext ^ (key_hi & BITMASK_32);
+    uint32_t tag = ciphertext ^ ((key_hi >> 32) & BITMASK_32);
     
-    /* Perform exactly num_rounds complete rounds */
+    if (outputs != NULL) outputs[0] = ((uint64_t)tag << 32) | plaintext;
     for (int round = 0; round < num_rounds; round++) {
-        /* Add round constant to key */
-        key.hi ^= ROUND_CONSTANTS[round];
-        
-        /* Nonlinear layer */
         plaintext = chichi_transform(plaintext, BITMASK_15, BITMASK_17, 16);
         tag = chichi_transform(tag, BITMASK_15, BITMASK_17, 16);
-        tweak = chichi_transform(tweak, BITMASK_31, BITMASK_33, 32);
-        key = chichi_transform_128(key);
-        
-        /* Linear layer */
-        plaintext = apply_linear_32(plaintext, linear_matrix_32_state);
-        tag = apply_linear_32(tag, linear_matrix_32_prf);
-        tweak = apply_linear_64(tweak, linear_matrix_64);
-        key = apply_linear_128(key, linear_matrix_128);
-        
-        /* Interaction layer */
-        plaintext ^= (tweak & BITMASK_32);
-        tag ^= ((tweak >> 32) & BITMASK_32);
-        tweak ^= key.lo;
+        plaintext = linear_layer_state_32(plaintext);
+        tag = linear_layer_prf_32(tag);
+        plaintext ^= (masks[round] & BITMASK_32);
+        tag ^= ((masks[round] >> 32) & BITMASK_32);
+        if (outputs != NULL) outputs[round + 1] = ((uint64_t)tag << 32) | plaintext;
     }
     
     return ((uint64_t)tag << 32) | (plaintext & BITMASK_32);
 }
 
-/* ========================================================================== */
-/*                              PUBLIC INTERFACE                             */
-/* ========================================================================== */
+/**
+ * State path of num_rounds complete 40-bit rounds (see masked_complete_rounds_32)
+ */
+static inline uint64_t masked_complete_rounds_40(uint64_t key_hi, uint64_t ciphertext, const uint64_t* masks,
+                                                 int num_rounds, uint64_t* outputs) {
+    uint64_t plaintext = (ciphertext ^ key_hi) & BITMASK_40;
+    
+    if (outputs != NULL) outputs[0] = plaintext;
+    for (int round = 0; round < num_rounds; round++) {
+        plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
+        plaintext = linear_layer_state_40(plaintext);
+        plaintext = (plaintext ^ masks[round]) & BITMASK_40;
+        if (outputs != NULL) outputs[round + 1] = plaintext;
+    }
+    
+    return plaintext;
+}
 
 /**
- * Initialize the ChiLow implementation
- * Must be called before using any decryption functions
+ * State and tag path of a full 32-bit decryption with precomputed tweak masks
+ * (tweak_schedule): the complete rounds, then the final round without a linear layer
  */
-void chilow_init(void) {
-    initialize_linear_matrices();
+static uint64_t masked_decrypt_32(uint64_t key_hi, uint32_t ciphertext, const uint64_t* masks) {
+    uint64_t state = masked_complete_rounds_32(key_hi, ciphertext, masks, NUM_ROUNDS - 1, NULL);
+    uint32_t plaintext = chichi_transform((uint32_t)state, BITMASK_15, BITMASK_17, 16);
+    uint32_t tag = chichi_transform((uint32_t)(state >> 32), BITMASK_15, BITMASK_17, 16);
+    
+    plaintext ^= (masks[NUM_ROUNDS - 1] & BITMASK_32);
+    tag ^= ((masks[NUM_ROUNDS - 1] >> 32) & BITMASK_32);
+    return ((uint64_t)tag << 32) | plaintext;
 }
 
 /**
- * ChiLow decryption - 32-bit variant
+ * State path of a full 40-bit decryption with precomputed tweak masks
  */
-uint64_t chilow_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_32(ciphertext, tweak, key);
+static uint64_t masked_decrypt_40(uint64_t key_hi, uint64_t ciphertext, const uint64_t* masks) {
+    uint64_t plaintext = masked_complete_rounds_40(key_hi, ciphertext, masks, NUM_ROUNDS - 1, NULL);
+    
+    plaintext = chichi_transform(plaintext, BITMASK_19, BITMASK_21, 20);
+    return (plaintext ^ masks[NUM_ROUNDS - 1]) & BITMASK_40;
 }
 
 /**
- * ChiLow decryption - 40-bit variant  
+ * Find the masks for (tweak, variant), filling the least recently used slot of the
+ * probe window on a miss. Probing always covers the whole window, so evictions never
+ * break a probe chain and no tombstones are needed.
  */
-uint64_t chilow_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_40(ciphertext, tweak, key);
+static const uint64_t* tweak_cache_lookup(chilow_tweak_cache_t* cache, uint64_t tweak, int variant) {
+    uint64_t hash = (tweak ^ ((uint64_t)variant << 62)) * 0x9E3779B97F4A7C15ULL;
+    size_t home = (size_t)(hash >> 32) & (CHILOW_TWEAK_CACHE_SLOTS - 1);
+    chilow_tweak_entry_t* victim = NULL;
+    
+    cache->clock++;
+    for (int probe = 0; probe < CHILOW_TWEAK_CACHE_PROBE; probe++) {
+        chilow_tweak_entry_t* entry = &cache->slots[(home + probe) & (CHILOW_TWEAK_CACHE_SLOTS - 1)];
+        if (entry->variant == variant && entry->tweak == tweak) {
+            entry->last_use = cache->clock;
+            cache->hits++;
+            return entry->masks;
+        }
+        if (victim == NULL || entry->last_use < victim->last_use) victim = entry;
+    }
+    
+    cache->misses++;
+    tweak_schedule(cache->ctx->key_lo, tweak,
+                   (variant == TWEAK_CACHE_VARIANT_40) ? cache->ctx->round_keys_40 : cache->ctx->round_keys_32,
+                   victim->masks);
+    victim->tweak = tweak;
+    victim->variant = variant;
+    victim->last_use = cache->clock;
+    return victim->masks;
 }
 
+/* ========================================================================== */
+/*                              ENCRYPTION                                   */
+/* ========================================================================== */
+
+/*
+ * Encryption runs the state path backwards. The tweak and key paths do not depend on
+ * the state, so their interaction masks are computed forward first (tweak_schedule).
+ * Then each round is undone in reverse order: interaction, inverse state layer, inverse
+ * chichi. The 32-bit tag is a function of the ciphertext, so it is computed forward
+ * once the ciphertext is known.
+ */
+
 /**
- * ChiLow decryption - 32-bit variant with reduced rounds
+ * ChiLow encryption for 32-bit plaintext with expanded round keys: returns
+ * (tag << 32) | ciphertext such that chilow_decrypt_32bit(ciphertext) returns
+ * (tag << 32) | plaintext
  */
-uint64_t chilow_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_32_reduced(ciphertext, tweak, key, num_rounds);
+static uint64_t encrypt_32_keys(uint32_t plaintext, uint64_t tweak, uint128_t key,
+                                const uint64_t* round_keys) {
+    uint64_t masks[NUM_ROUNDS];
+    uint64_t state = plaintext;
+    uint32_t ciphertext;
+    
+    tweak_schedule(key.lo, tweak, round_keys, masks);
+    
+    /* Undo the final round, then the full rounds in reverse order */
+    state ^= masks[NUM_ROUNDS - 1] & BITMASK_32;
+    state = chichi_inverse(state, BITMASK_15, BITMASK_17, 16);
+    for (int round = NUM_ROUNDS - 2; round >= 0; round--) {
+        state ^= masks[round] & BITMASK_32;
+        state = linear_layer_state_32_inv((uint32_t)state);
+        state = chichi_inverse(state, BITMASK_15, BITMASK_17, 16);
+    }
+    
+    /* Undo the initial whitening and recompute the tag from the ciphertext */
+    ciphertext = (uint32_t)(state ^ (key.hi & BITMASK_32));
+    return (masked_decrypt_32(key.hi, ciphertext, masks) & ~BITMASK_32) | ciphertext;
 }
 
 /**
- * ChiLow decryption - 40-bit variant with reduced rounds
+ * ChiLow encryption for 32-bit plaintext, expanding the round keys first
  */
-uint64_t chilow_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_40_reduced(ciphertext, tweak, key, num_rounds);
+static uint64_t chilow_encrypt_32(uint32_t plaintext, uint64_t tweak, uint128_t key) {
+    uint64_t round_keys[NUM_ROUNDS];
+    
+    expand_round_keys(key, ROUND_CONSTANTS, NUM_ROUNDS, round_keys);
+    return encrypt_32_keys(plaintext, tweak, key, round_keys);
 }
 
 /**
- * ChiLow decryption - 32-bit variant with reduced rounds, without final linear layer
+ * ChiLow encryption for 40-bit plaintext with expanded round keys (inverse of
+ * chilow_decrypt_40)
  */
-uint64_t chilow_half_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_32_half_reduced(ciphertext, tweak, key, num_rounds);
+static uint64_t encrypt_40_keys(uint64_t plaintext, uint64_t tweak, uint128_t key,
+                                const uint64_t* round_keys) {
+    uint64_t masks[NUM_ROUNDS];
+    uint64_t state = plaintext & BITMASK_40;
+    
+    tweak_schedule(key.lo, tweak, round_keys, masks);
+    
+    state ^= masks[NUM_ROUNDS - 1] & BITMASK_40;
+    state = chichi_inverse(state, BITMASK_19, BITMASK_21, 20);
+    for (int round = NUM_ROUNDS - 2; round >= 0; round--) {
+        state ^= masks[round] & BITMASK_40;
+        state = linear_layer_state_40_inv(state);
+        state = chichi_inverse(state, BITMASK_19, BITMASK_21, 20);
+    }
+    
+    return (state ^ (key.hi & BITMASK_40)) & BITMASK_40;
 }
 
 /**
- * ChiLow decryption - 32-bit variant with exactly num_rounds complete rounds (for integral cryptanalysis)
+ * ChiLow encryption for 40-bit plaintext, expanding the round keys first
  */
-uint64_t chilow_complete_rounds_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_32_complete_rounds(ciphertext, tweak, key, num_rounds);
+static uint64_t chilow_encrypt_40(uint64_t plaintext, uint64_t tweak, uint128_t key) {
+    uint64_t round_keys[NUM_ROUNDS];
+    
+    expand_round_keys(key, ROUND_CONSTANTS_40, NUM_ROUNDS, round_keys);
+    return encrypt_40_keys(plaintext, tweak, key, round_keys);
 }
 
+/* ========================================================================== */
+/*                              BITSLICED ENGINE                             */
+/* ========================================================================== */
+
+/*
+ * In the bitsliced representation, slice i holds bit i of every block in the
+ * batch (one block per lane). Rotations and linear layers become plain word
+ * renames, and chi becomes one AND-NOT and one XOR per slice. The 64-lane
+ * engine uses a uint64_t per slice, while the 256- and 512-lane engines use
+ * GCC vector types that map onto AVX2/AVX-512 registers when available.
+ */
+typedef uint64_t bs64_t;
+typedef uint64_t bs256_t __attribute__((vector_size(32)));
+typedef uint64_t bs512_t __attribute__((vector_size(64)));
+
+#define BS_MAX_LIMBS 8
+
 /**
- * ChiLow decryption - 40-bit variant with exactly num_rounds complete rounds (for integral cryptanalysis)
+ * In-place transpose of a 64x64 bit matrix: bit j of a[i] moves to bit i of a[j]
  */
-uint64_t chilow_complete_rounds_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_40_complete_rounds(ciphertext, tweak, key, num_rounds);
+static void transpose_64x64(uint64_t a[64]) {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
 }
 
 /**
- * ChiLow decryption - 40-bit variant with reduced rounds, without final linear layer
+ * Bitsliced chi on `width` slices starting at `base` (rotations are index shifts)
  */
-uint64_t chilow_half_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
-    uint128_t key = {key_lo, key_hi};
-    return chilow_decrypt_40_half_reduced(ciphertext, tweak, key, num_rounds);
+#define BS_CHI(out, in, base, width) do {                                                       \
+    for (int i_ = 0; i_ < (width) - 2; i_++)                                                    \
+        (out)[(base) + i_] = (in)[(base) + i_] ^ (~(in)[(base) + i_ + 1] & (in)[(base) + i_ + 2]); \
+    (out)[(base) + (width) - 2] = (in)[(base) + (width) - 2] ^ (~(in)[(base) + (width) - 1] & (in)[base]); \
+    (out)[(base) + (width) - 1] = (in)[(base) + (width) - 1] ^ (~(in)[base] & (in)[(base) + 1]); \
+} while (0)
+
+/**
+ * Bitsliced counterpart of chichi_transform (also covers chichi_transform_128 with split 64)
+ */
+#define BS_CHICHI(out, in, split) do {                                                          \
+    BS_CHI(out, in, 0, (split) - 1);                                                            \
+    BS_CHI(out, in, (split) - 1, (split) + 1);                                                  \
+    (out)[(split) - 3] ^= (in)[split] ^ (in)[(split) - 3];                                      \
+    (out)[(split) - 2] ^= (in)[(split) - 1] ^ (in)[(split) - 2];                                \
+    (out)[(split) - 1] ^= (in)[(split) - 3] ^ (in)[(split) - 1] ^ (in)[split];                  \
+    (out)[split] ^= (in)[split] ^ (in)[(split) - 2];                                            \
+} while (0)
+
+/**
+ * Bitsliced linear layer: each output slice is the XOR of three input slices
+ */
+#define BS_LINEAR(out, in, n, params) do {                                                      \
+    for (int i_ = 0; i_ < (n); i_++)                                                            \
+        (out)[i_] = (in)[((params)->alpha[0] * i_ + (params)->beta[0]) % (n)] ^                 \
+                    (in)[((params)->alpha[1] * i_ + (params)->beta[1]) % (n)] ^                 \
+                    (in)[((params)->alpha[2] * i_ + (params)->beta[2]) % (n)];                  \
+} while (0)
+
+/**
+ * XOR a constant shared by all lanes into `n` slices
+ */
+#define BS_XOR_CONST(x, n, value) do {                                                          \
+    for (int i_ = 0; i_ < (n); i_++)                                                            \
+        (x)[i_] ^= (uint64_t)0 - (((value) >> i_) & 1);                                         \
+} while (0)
+
+/**
+ * Define the round kernels for one slice type. `num_rounds` complete rounds are
+ * applied, followed by the simplified final round when `final_round` is set.
+ * They are inlined into each per-ISA chunk kernel (see RUNTIME KERNEL DISPATCH).
+ */
+#define BS_DEFINE_KERNELS(NAME, WORD)                                                           \
+static CONST_INLINE void bs_kernel_32_##NAME(WORD* p, WORD* t, WORD* tw, uint64_t key_hi, uint64_t key_lo,   \
+                                const uint64_t* round_keys, int num_rounds, int final_round) {  \
+    WORD a[64];                                                                                 \
+    BS_XOR_CONST(p, 32, key_hi);                                                                \
+    BS_XOR_CONST(t, 32, key_hi >> 32);                                                          \
+    BS_XOR_CONST(tw, 64, key_lo);                                                               \
+    for (int round = 0; round < num_rounds; round++) {                                          \
+        BS_CHICHI(a, p, 16);                                                                    \
+        BS_LINEAR(p, a, 32, &STATE_PARAMS);                                                     \
+        BS_CHICHI(a, t, 16);                                                                    \
+        BS_LINEAR(t, a, 32, &PRF_PARAMS);                                                       \
+        BS_CHICHI(a, tw, 32);                                                                   \
+        BS_LINEAR(tw, a, 64, &TWEAK_PARAMS);                                                    \
+        for (int i = 0; i < 32; i++) {                                                          \
+            p[i] ^= tw[i];                                                                      \
+            t[i] ^= tw[32 + i];                                                                 \
+        }                                                                                       \
+        BS_XOR_CONST(tw, 64, round_keys[round]);                                                \
+    }                                                                                           \
+    if (final_round) {                                                                          \
+        WORD f[64];                                                                             \
+        BS_CHICHI(a, p, 16);                                                                    \
+        BS_CHICHI(a + 32, t, 16);                                                               \
+        BS_LINEAR(f, tw, 64, &TWEAK_PARAMS);                                                    \
+        for (int i = 0; i < 32; i++) {                                                          \
+            p[i] = a[i] ^ f[i];                                                                 \
+            t[i] = a[32 + i] ^ f[32 + i];                                                       \
+        }                                                                                       \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+static CONST_INLINE void bs_kernel_40_##NAME(WORD* p, WORD* tw, uint64_t key_hi, uint64_t key_lo,\
+                                const uint64_t* round_keys, int num_rounds, int final_round) {  \
+    WORD a[64];                                                                                 \
+    BS_XOR_CONST(p, 40, key_hi);                                                                \
+    BS_XOR_CONST(tw, 64, key_lo);                                                               \
+    for (int round = 0; round < num_rounds; round++) {                                          \
+        BS_CHICHI(a, p, 20);                                                                    \
+        BS_LINEAR(p, a, 40, &STATE40_PARAMS);                                                   \
+        BS_CHICHI(a, tw, 32);                                                                   \
+        BS_LINEAR(tw, a, 64, &TWEAK_PARAMS);                                                    \
+        for (int i = 0; i < 40; i++) {                                                          \
+            p[i] ^= tw[i];                                                                      \
+        }                                                                                       \
+        BS_XOR_CONST(tw, 64, round_keys[round]);                                                \
+    }                                                                                           \
+    if (final_round) {                                                                          \
+        WORD f[64];                                                                             \
+        BS_CHICHI(a, p, 20);                                                                    \
+        BS_LINEAR(f, tw, 64, &TWEAK_PARAMS);                                                    \
+        for (int i = 0; i < 40; i++) {                                                          \
+            p[i] = a[i] ^ f[i];                                                                 \
+        }                                                                                       \
+    }                                                                                           \
+}
+
+BS_DEFINE_KERNELS(64, bs64_t)
+BS_DEFINE_KERNELS(256, bs256_t)
+BS_DEFINE_KERNELS(512, bs512_t)
+
+/**
+ * Transpose up to 64 lanes of group `group` into slice-major layout
+ * (slices[bit * limbs + group]); missing lanes are zero
+ */
+static void bs_load_group(uint64_t* slices, int limbs, int group, int width,
+                          const uint64_t* values, size_t count) {
+    uint64_t m[64] = {0};
+    for (size_t lane = 0; lane < count && lane < 64; lane++) {
+        m[lane] = values[lane];
+    }
+    transpose_64x64(m);
+    for (int bit = 0; bit < width; bit++) {
+        slices[bit * limbs + group] = m[bit];
+    }
+}
+
+/**
+ * Inverse of bs_load_group: write back up to 64 lanes of `width` bits
+ */
+static void bs_store_group(const uint64_t* slices, int limbs, int group, int width,
+                           uint64_t* values, size_t count) {
+    uint64_t m[64] = {0};
+    for (int bit = 0; bit < width; bit++) {
+        m[bit] = slices[bit * limbs + group];
+    }
+    transpose_64x64(m);
+    for (size_t lane = 0; lane < count && lane < 64; lane++) {
+        values[lane] = m[lane];
+    }
+}
+
+/**
+ * Load a batch of up to 64 * limbs blocks into slice-major buffers
+ * (32-bit ciphertexts are widened so the transpose can treat all inputs alike)
+ */
+static void bs_load_batch(uint64_t* state_slices, uint64_t* tweak_slices, int limbs, int state_bits,
+                          const uint32_t* ciphertexts_32, const uint64_t* ciphertexts_40,
+                          const uint64_t* tweaks, size_t count) {
+    for (int group = 0; group < limbs; group++) {
+        size_t offset = (size_t)group * 64;
+        size_t lanes = (count > offset) ? count - offset : 0;
+        uint64_t widened[64];
+        if (lanes > 64) lanes = 64;
+        for (size_t lane = 0; lane < lanes; lane++) {
+            widened[lane] = ciphertexts_32 ? ciphertexts_32[offset + lane]
+                                           : (ciphertexts_40[offset + lane] & BITMASK_40);
+        }
+        bs_load_group(state_slices, limbs, group, state_bits, widened, lanes);
+        bs_load_group(tweak_slices, limbs, group, 64, tweaks + offset, lanes);
+    }
+}
+
+static void bs_store_batch(const uint64_t* out_slices, int limbs, uint64_t* results, size_t count) {
+    for (int group = 0; group < limbs; group++) {
+        size_t offset = (size_t)group * 64;
+        size_t lanes = (count > offset) ? count - offset : 0;
+        if (lanes > 64) lanes = 64;
+        bs_store_group(out_slices, limbs, group, 64, results + offset, lanes);
+    }
+}
+
+/**
+ * Run 64 * limbs blocks in slice-major layout (ciphertext slices in p, tweak slices in tw)
+ * through the engine of matching width, leaving the output slices in p: plaintext then
+ * tag (32-bit variant) or the 40-bit state
+ */
+static CONST_INLINE void bs_run_slices(int variant_40, int limbs, uint64_t* p, uint64_t* tw,
+                                       uint64_t key_hi, uint64_t key_lo, const uint64_t* round_keys,
+                                       int num_rounds, int final_round) {
+    uint64_t t[64 * BS_MAX_LIMBS] = {0};
+    int state_bits = variant_40 ? 40 : 32;
+
+    if (!variant_40) {
+        memcpy(t, p, sizeof(uint64_t) * 32 * limbs);
+    }
+
+    if (limbs == 8) {
+        bs512_t vp[40], vt[32], vtw[64];
+        memcpy(vp, p, sizeof(bs512_t) * state_bits);
+        memcpy(vt, t, sizeof vt);
+        memcpy(vtw, tw, sizeof vtw);
+        if (variant_40) {
+            bs_kernel_40_512(vp, vtw, key_hi, key_lo, round_keys, num_rounds, final_round);
+        } else {
+            bs_kernel_32_512(vp, vt, vtw, key_hi, key_lo, round_keys, num_rounds, final_round);
+            memcpy(p + 32 * limbs, vt, sizeof vt);
+        }
+        memcpy(p, vp, sizeof(bs512_t) * state_bits);
+    } else if (limbs == 4) {
+        bs256_t vp[40], vt[32], vtw[64];
+        memcpy(vp, p, sizeof(bs256_t) * state_bits);
+        memcpy(vt, t, sizeof vt);
+        memcpy(vtw, tw, sizeof vtw);
+        if (variant_40) {
+            bs_kernel_40_256(vp, vtw, key_hi, key_lo, round_keys, num_rounds, final_round);
+        } else {
+            bs_kernel_32_256(vp, vt, vtw, key_hi, key_lo, round_keys, num_rounds, final_round);
+            memcpy(p + 32 * limbs, vt, sizeof vt);
+        }
+        memcpy(p, vp, sizeof(bs256_t) * state_bits);
+    } else {
+        if (variant_40) {
+            bs_kernel_40_64(p, tw, key_hi, key_lo, round_keys, num_rounds, final_round);
+        } else {
+            bs_kernel_32_64(p, t, tw, key_hi, key_lo, round_keys, num_rounds, final_round);
+            memcpy(p + 32, t, sizeof(uint64_t) * 32);
+        }
+    }
+}
+
+/**
+ * Load up to 64 * limbs blocks and run them with bs_run_slices
+ */
+static CONST_INLINE void bs_run_chunk(int variant_40, int limbs, const uint32_t* ciphertexts_32,
+                                      const uint64_t* ciphertexts_40, const uint64_t* tweaks,
+                                      uint64_t key_hi, uint64_t key_lo, const uint64_t* round_keys,
+                                      int num_rounds, int final_round, uint64_t* p, size_t count) {
+    uint64_t tw[64 * BS_MAX_LIMBS];
+
+    bs_load_batch(p, tw, limbs, variant_40 ? 40 : 32, ciphertexts_32, ciphertexts_40, tweaks, count);
+    bs_run_slices(variant_40, limbs, p, tw, key_hi, key_lo, round_keys, num_rounds, final_round);
+}
+
+/**
+ * Decrypt up to 64 * limbs blocks with the engine of matching width
+ * (instantiated once per ISA as a bs_chunk_fn)
+ */
+static CONST_INLINE void bs_decrypt_chunk(int variant_40, int limbs, const uint32_t* ciphertexts_32,
+                                          const uint64_t* ciphertexts_40, const uint64_t* tweaks,
+                                          uint64_t key_hi, uint64_t key_lo, const uint64_t* round_keys,
+                                          int num_rounds, int final_round, uint64_t* results,
+                                          size_t count) {
+    uint64_t p[64 * BS_MAX_LIMBS];
+
+    bs_run_chunk(variant_40, limbs, ciphertexts_32, ciphertexts_40, tweaks, key_hi, key_lo,
+                 round_keys, num_rounds, final_round, p, count);
+
+    /* Output slices: 32-bit variant is plaintext || tag, 40-bit variant is zero-extended */
+    if (variant_40) {
+        memset(p + 40 * limbs, 0, sizeof(uint64_t) * 24 * limbs);
+    }
+    bs_store_batch(p, limbs, results, count);
+}
+
+typedef void (*bs_chunk_fn)(int variant_40, int limbs, const uint32_t* ciphertexts_32,
+                            const uint64_t* ciphertexts_40, const uint64_t* tweaks,
+                            uint64_t key_hi, uint64_t key_lo, const uint64_t* round_keys,
+                            int num_rounds, int final_round, uint64_t* results, size_t count);
+
+/**
+ * Decrypt up to 64 * limbs 32-bit blocks and compare their tags: each group of 64 lanes
+ * is transposed back once and its tags compared lane by lane into bitmap[group].
+ * Plaintexts are stored for verified blocks only, and only when requested.
+ */
+static CONST_INLINE void bs_verify_chunk(int limbs, const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                         const uint32_t* tags, uint64_t key_hi, uint64_t key_lo,
+                                         const uint64_t* round_keys, uint64_t* bitmap,
+                                         uint32_t* plaintexts, size_t count) {
+    uint64_t p[64 * BS_MAX_LIMBS];
+
+    bs_run_chunk(0, limbs, ciphertexts, NULL, tweaks, key_hi, key_lo, round_keys, NUM_ROUNDS - 1,
+                 FINAL_ROUND_FULL, p, count);
+
+    for (int group = 0; group < limbs; group++) {
+        size_t offset = (size_t)group * 64;
+        size_t lanes = (count > offset) ? count - offset : 0;
+        uint64_t values[64], valid = 0;
+        if (lanes == 0) break;
+        if (lanes > 64) lanes = 64;
+
+        bs_store_group(p, limbs, group, 64, values, lanes);
+        for (size_t lane = 0; lane < lanes; lane++) {
+            valid |= (uint64_t)((uint32_t)(values[lane] >> 32) == tags[offset + lane]) << lane;
+        }
+        bitmap[group] = valid;
+
+        if (plaintexts != NULL) {
+            for (size_t lane = 0; lane < lanes; lane++) {
+                if ((valid >> lane) & 1) plaintexts[offset + lane] = (uint32_t)values[lane];
+            }
+        }
+    }
+}
+
+typedef void (*bs_verify_fn)(int limbs, const uint32_t* ciphertexts, const uint64_t* tweaks,
+                             const uint32_t* tags, uint64_t key_hi, uint64_t key_lo,
+                             const uint64_t* round_keys, uint64_t* bitmap, uint32_t* plaintexts,
+                             size_t count);
+
+/**
+ * Split a batch of any size over the 512-, 256- and 64-lane engines of `chunk`,
+ * with the round keys already expanded
+ */
+static void bs_decrypt_range(bs_chunk_fn chunk, int variant_40, const uint32_t* ciphertexts_32,
+                             const uint64_t* ciphertexts_40, const uint64_t* tweaks,
+                             uint64_t key_hi, uint64_t key_lo, const uint64_t* round_keys,
+                             int num_rounds, int final_round, uint64_t* results, size_t num_blocks) {
+    size_t done = 0;
+
+    while (done < num_blocks) {
+        size_t remaining = num_blocks - done;
+        int limbs = (remaining >= 512) ? 8 : (remaining >= 256) ? 4 : 1;
+        size_t count = (remaining < (size_t)limbs * 64) ? remaining : (size_t)limbs * 64;
+
+        chunk(variant_40, limbs,
+              ciphertexts_32 ? ciphertexts_32 + done : NULL,
+              ciphertexts_40 ? ciphertexts_40 + done : NULL,
+              tweaks + done, key_hi, key_lo, round_keys, num_rounds, final_round,
+              results + done, count);
+        done += count;
+    }
+}
+
+/**
+ * Expand the round keys, then decrypt a batch of any size with bs_decrypt_range
+ */
+static void bs_decrypt_batch(bs_chunk_fn chunk, int variant_40, const uint32_t* ciphertexts_32,
+                             const uint64_t* ciphertexts_40, const uint64_t* tweaks,
+                             uint64_t key_hi, uint64_t key_lo, int num_rounds, int final_round,
+                             uint64_t* results, size_t num_blocks) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t round_keys[NUM_ROUNDS];
+
+    expand_round_keys(key, variant_40 ? ROUND_CONSTANTS_40 : ROUND_CONSTANTS,
+                      num_rounds, round_keys);
+    bs_decrypt_range(chunk, variant_40, ciphertexts_32, ciphertexts_40, tweaks, key_hi, key_lo,
+                     round_keys, num_rounds, final_round, results, num_blocks);
+}
+
+/*
+ * Cube sums: the 64 * limbs lanes of one pass hold cube elements start .. start + 64 * limbs
+ * - 1 (start a multiple of 64 * limbs), built directly as slices. Bit j of the element
+ * index is a fixed lane pattern for j < 6, the limb number for the next bits and constant
+ * above, so the Gray-code bit j ^ (j + 1) of each active position costs one XOR per word
+ * and no transpose. Outputs are XOR-folded across limbs into one word per output bit; the
+ * sum bit is the parity of that word, taken once at the end.
+ */
+static const uint64_t BS_LANE_INDEX_BITS[6] = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+};
+
+/**
+ * XOR the output slices of the lanes in lane_masks into acc[bit]
+ */
+static CONST_INLINE void bs_cube_fold(const uint64_t* slices, int limbs, int output_bits,
+                                      const uint64_t* lane_masks, uint64_t* acc) {
+    for (int bit = 0; bit < output_bits; bit++) {
+        uint64_t fold = 0;
+        for (int group = 0; group < limbs; group++) {
+            fold ^= slices[bit * limbs + group] & lane_masks[group];
+        }
+        acc[bit] ^= fold;
+    }
+}
+
+/**
+ * State (and tag) path of complete rounds with the tweak words of the integral schedule
+ * XORed in as constants, for one slice type. bs_cube_pass_* whitens the pass, runs it to
+ * num_rounds and folds the outputs into acc; with every_round set it also folds after
+ * each smaller round count r, into acc + 64 * r.
+ */
+#define BS_DEFINE_MASKED_KERNELS(NAME, WORD)                                                    \
+static CONST_INLINE void bs_masked_32_##NAME(WORD* p, WORD* t, const uint64_t* masks,           \
+                                             int first_round, int last_round) {                 \
+    WORD a[32];                                                                                 \
+    for (int round = first_round; round < last_round; round++) {                                \
+        BS_CHICHI(a, p, 16);                                                                    \
+        BS_LINEAR(p, a, 32, &STATE_PARAMS);                                                     \
+        BS_CHICHI(a, t, 16);                                                                    \
+        BS_LINEAR(t, a, 32, &PRF_PARAMS);                                                       \
+        BS_XOR_CONST(p, 32, masks[round]);                                                      \
+        BS_XOR_CONST(t, 32, masks[round] >> 32);                                                \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+static CONST_INLINE void bs_masked_40_##NAME(WORD* p, const uint64_t* masks, int first_round,   \
+                                             int last_round) {                                  \
+    WORD a[40];                                                                                 \
+    for (int round = first_round; round < last_round; round++) {                                \
+        BS_CHICHI(a, p, 20);                                                                    \
+        BS_LINEAR(p, a, 40, &STATE40_PARAMS);                                                   \
+        BS_XOR_CONST(p, 40, masks[round]);                                                      \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+static CONST_INLINE void bs_cube_pass_##NAME(int variant_40, int limbs, uint64_t* slices,        \
+                                             uint64_t key_hi, const uint64_t* masks,            \
+                                             int num_rounds, int every_round,                   \
+                                             const uint64_t* lane_masks, uint64_t* acc) {       \
+    int output_bits = variant_40 ? 40 : 64;                                                     \
+    int done = 0;                                                                               \
+    WORD v[64];                                                                                 \
+    memcpy(v, slices, sizeof(WORD) * output_bits);                                              \
+    BS_XOR_CONST(v, variant_40 ? 40 : 32, key_hi);                                              \
+    if (!variant_40) BS_XOR_CONST(v + 32, 32, key_hi >> 32);                                    \
+    for (int rounds = every_round ? 0 : num_rounds; rounds <= num_rounds; rounds++) {           \
+        if (variant_40) {                                                                       \
+            bs_masked_40_##NAME(v, masks, done, rounds);                                        \
+        } else {                                                                                \
+            bs_masked_32_##NAME(v, v + 32, masks, done, rounds);                                \
+        }                                                                                       \
+        done = rounds;                                                                          \
+        memcpy(slices, v, sizeof(WORD) * output_bits);                                          \
+        bs_cube_fold(slices, limbs, output_bits, lane_masks,                                    \
+                     every_round ? acc + 64 * rounds : acc);                                    \
+    }                                                                                           \
+}
+
+BS_DEFINE_MASKED_KERNELS(64, bs64_t)
+BS_DEFINE_MASKED_KERNELS(256, bs256_t)
+BS_DEFINE_MASKED_KERNELS(512, bs512_t)
+
+/**
+ * Slice-major inputs of the pass at cube index start (64 slices of limbs words)
+ */
+static void bs_cube_slices(const chilow_cube_t* cube, int limbs, uint64_t start, uint64_t* slices) {
+    for (int group = 0; group < limbs; group++) {
+        uint64_t word = (start >> 6) + (uint64_t)group;
+        uint64_t index_bits[65];
+        
+        for (int j = 0; j <= cube->num_active; j++) {
+            index_bits[j] = (j < 6) ? BS_LANE_INDEX_BITS[j] : (uint64_t)0 - ((word >> (j - 6)) & 1);
+        }
+        for (int bit = 0; bit < 64; bit++) {
+            slices[bit * limbs + group] = (uint64_t)0 - ((cube->base >> bit) & 1);
+        }
+        for (int j = 0; j < cube->num_active; j++) {
+            slices[cube->positions[j] * limbs + group] = index_bits[j] ^ index_bits[j + 1];
+        }
+    }
+}
+
+/**
+ * Run one pass of cube inputs (consumed) through num_rounds complete rounds under the
+ * tweak masks of the cube's integral schedule, and XOR the outputs of the lanes in
+ * lane_masks into acc[bit]; with every_round set, the outputs after r rounds go to
+ * acc[64 * r + bit] for every r up to num_rounds (instantiated once per ISA as a bs_cube_fn)
+ */
+static CONST_INLINE void bs_cube_chunk(int variant_40, int limbs, uint64_t* slices, uint64_t key_hi,
+                                       const uint64_t* masks, int num_rounds, int every_round,
+                                       const uint64_t* lane_masks, uint64_t* acc) {
+    /* The 32-bit tag path starts from the ciphertext slices too */
+    if (!variant_40) {
+        memcpy(slices + 32 * limbs, slices, sizeof(uint64_t) * 32 * limbs);
+    }
+    if (limbs == 8) {
+        bs_cube_pass_512(variant_40, limbs, slices, key_hi, masks, num_rounds, every_round, lane_masks, acc);
+    } else if (limbs == 4) {
+        bs_cube_pass_256(variant_40, limbs, slices, key_hi, masks, num_rounds, every_round, lane_masks, acc);
+    } else {
+        bs_cube_pass_64(variant_40, limbs, slices, key_hi, masks, num_rounds, every_round, lane_masks, acc);
+    }
+}
+
+typedef void (*bs_cube_fn)(int variant_40, int limbs, uint64_t* slices, uint64_t key_hi,
+                           const uint64_t* masks, int num_rounds, int every_round,
+                           const uint64_t* lane_masks, uint64_t* acc);
+
+/* ========================================================================== */
+/*                              PARAMETERIZED ENGINE                         */
+/* ========================================================================== */
+
+/*
+ * ChiLow-n from a chilow_spec_t. chilow_engine_init() generates the round constants
+ * (round_constants.py rule), the round keys and the two linear layers as index tables.
+ * The batch kernel is the bitsliced engine with the state width, split and layers read
+ * from the engine: chi and the interaction layer loop over n slices, and each linear
+ * layer output slice is the XOR of three indexed input slices. It is compiled per ISA
+ * through KERNEL_DEFINE like the fixed-width kernels. engine_spec_block() is the scalar
+ * reference, built from chichi_transform and the index tables.
+ */
+
+/**
+ * Round constant i of the round_constants.py rule, truncated to 64 bits
+ */
+static uint64_t spec_round_constant(uint64_t flags, int round) {
+    return flags + (((((uint64_t)1 << round) << 4) + (uint64_t)round) << 32);
+}
+
+static int spec_valid(const chilow_spec_t* spec) {
+    if (spec->state_width < 8 || spec->state_width > 64 || spec->state_width % 2 != 0) return 0;
+    if (spec->num_rounds < 1 || spec->num_rounds > CHILOW_SPEC_MAX_ROUNDS) return 0;
+    for (int k = 0; k < 3; k++) {
+        if (spec->state_alpha[k] < 0 || spec->state_beta[k] < 0) return 0;
+        if (spec->tag && (spec->prf_alpha[k] < 0 || spec->prf_beta[k] < 0)) return 0;
+    }
+    return 1;
+}
+
+static void spec_linear_index(uint8_t index[3][64], const int* alpha, const int* beta, int width) {
+    for (int row = 0; row < width; row++) {
+        for (int k = 0; k < 3; k++) {
+            index[k][row] = (uint8_t)((alpha[k] * row + beta[k]) % width);
+        }
+    }
+}
+
+static uint64_t spec_linear(uint64_t input, const uint8_t index[3][64], int width) {
+    uint64_t output = 0;
+    for (int row = 0; row < width; row++) {
+        uint64_t bit = (input >> index[0][row]) ^ (input >> index[1][row]) ^ (input >> index[2][row]);
+        output |= (bit & 1) << row;
+    }
+    return output;
+}
+
+/**
+ * Scalar reference: one block through the engine, returns the plaintext (tag via *tag)
+ */
+static uint64_t engine_spec_block(const chilow_engine_t* engine, uint64_t ciphertext, uint64_t tweak,
+                                  uint64_t* tag_out) {
+    int width = engine->spec.state_width, split = width / 2, shift = 64 - width;
+    uint64_t mask = (width == 64) ? ~0ULL : (1ULL << width) - 1;
+    uint64_t small_mask = (1ULL << (split - 1)) - 1, large_mask = (1ULL << (split + 1)) - 1;
+    uint64_t p = (ciphertext ^ engine->key_hi) & mask;
+    uint64_t t = (ciphertext ^ (engine->key_hi >> shift)) & mask;
+    
+    tweak ^= engine->key_lo;
+    for (int round = 0; round < engine->spec.num_rounds - 1; round++) {
+        p = spec_linear(chichi_transform(p, small_mask, large_mask, split), engine->state_index, width);
+        t = spec_linear(chichi_transform(t, small_mask, large_mask, split), engine->prf_index, width);
+        tweak = linear_layer_tweak_64(chichi_transform(tweak, BITMASK_31, BITMASK_33, 32));
+        p ^= tweak & mask;
+        t ^= (tweak >> shift) & mask;
+        tweak ^= engine->round_keys[round];
+    }
+    tweak = linear_layer_tweak_64(tweak);
+    p = (chichi_transform(p, small_mask, large_mask, split) ^ tweak) & mask;
+    t = (chichi_transform(t, small_mask, large_mask, split) ^ (tweak >> shift)) & mask;
+    
+    if (tag_out != NULL) *tag_out = engine->spec.tag ? t : 0;
+    return p;
+}
+
+/**
+ * Bitsliced linear layer from an index table
+ */
+#define BS_LINEAR_INDEX(out, in, n, index) do {                                                 \
+    for (int i_ = 0; i_ < (n); i_++)                                                            \
+        (out)[i_] = (in)[(index)[0][i_]] ^ (in)[(index)[1][i_]] ^ (in)[(index)[2][i_]];         \
+} while (0)
+
+#define BS_DEFINE_SPEC_KERNEL(NAME, WORD)                                                       \
+static CONST_INLINE void bs_kernel_spec_##NAME(const chilow_engine_t* engine, WORD* p, WORD* t, \
+                                               WORD* tw) {                                      \
+    WORD a[64], b[64];                                                                          \
+    int width = engine->spec.state_width, split = width / 2, shift = 64 - width;                \
+    int tag = engine->spec.tag;                                                                 \
+    BS_XOR_CONST(p, width, engine->key_hi);                                                     \
+    if (tag) BS_XOR_CONST(t, width, engine->key_hi >> shift);                                   \
+    BS_XOR_CONST(tw, 64, engine->key_lo);                                                       \
+    for (int round = 0; round < engine->spec.num_rounds - 1; round++) {                         \
+        BS_CHICHI(a, p, split);                                                                 \
+        BS_LINEAR_INDEX(p, a, width, engine->state_index);                                      \
+        if (tag) {                                                                              \
+            BS_CHICHI(a, t, split);                                                             \
+            BS_LINEAR_INDEX(t, a, width, engine->prf_index);                                    \
+        }                                                                                       \
+        BS_CHICHI(a, tw, 32);                                                                   \
+        BS_LINEAR(tw, a, 64, &TWEAK_PARAMS);                                                    \
+        for (int i = 0; i < width; i++) {                                                       \
+            p[i] ^= tw[i];                                                                      \
+        }                                                                                       \
+        if (tag) {                                                                              \
+            for (int i = 0; i < width; i++) {                                                   \
+                t[i] ^= tw[shift + i];                                                          \
+            }                                                                                   \
+        }                                                                                       \
+        BS_XOR_CONST(tw, 64, engine->round_keys[round]);                                        \
+    }                                                                                           \
+    BS_LINEAR(b, tw, 64, &TWEAK_PARAMS);                                                        \
+    BS_CHICHI(a, p, split);                                                                     \
+    for (int i = 0; i < width; i++) {                                                           \
+        p[i] = a[i] ^ b[i];                                                                     \
+    }                                                                                           \
+    if (tag) {                                                                                  \
+        BS_CHICHI(a, t, split);                                                                 \
+        for (int i = 0; i < width; i++) {                                                       \
+            t[i] = a[i] ^ b[shift + i];                                                         \
+        }                                                                                       \
+    }                                                                                           \
+}
+
+BS_DEFINE_SPEC_KERNEL(64, bs64_t)
+BS_DEFINE_SPEC_KERNEL(256, bs256_t)
+BS_DEFINE_SPEC_KERNEL(512, bs512_t)
+
+/**
+ * Run up to 64 * limbs blocks through the spec kernel of matching lane count
+ * (instantiated once per ISA as a bs_spec_fn)
+ */
+static CONST_INLINE void bs_spec_chunk(const chilow_engine_t* engine, int limbs, const uint64_t* ciphertexts,
+                                       const uint64_t* tweaks, uint64_t* plaintexts, uint64_t* tags,
+                                       size_t count) {
+    uint64_t p[64 * BS_MAX_LIMBS], t[64 * BS_MAX_LIMBS], tw[64 * BS_MAX_LIMBS];
+    int width = engine->spec.state_width;
+    
+    for (int group = 0; group < limbs; group++) {
+        size_t offset = (size_t)group * 64;
+        size_t lanes = (count > offset) ? count - offset : 0;
+        if (lanes > 64) lanes = 64;
+        bs_load_group(p, limbs, group, width, ciphertexts + offset, lanes);
+        bs_load_group(tw, limbs, group, 64, tweaks + offset, lanes);
+    }
+    memcpy(t, p, sizeof(uint64_t) * width * limbs);
+    
+    if (limbs == 8) {
+        bs512_t vp[64], vt[64], vtw[64];
+        memcpy(vp, p, sizeof(bs512_t) * width);
+        memcpy(vt, t, sizeof(bs512_t) * width);
+        memcpy(vtw, tw, sizeof vtw);
+        bs_kernel_spec_512(engine, vp, vt, vtw);
+        memcpy(p, vp, sizeof(bs512_t) * width);
+        memcpy(t, vt, sizeof(bs512_t) * width);
+    } else if (limbs == 4) {
+        bs256_t vp[64], vt[64], vtw[64];
+        memcpy(vp, p, sizeof(bs256_t) * width);
+        memcpy(vt, t, sizeof(bs256_t) * width);
+        memcpy(vtw, tw, sizeof vtw);
+        bs_kernel_spec_256(engine, vp, vt, vtw);
+        memcpy(p, vp, sizeof(bs256_t) * width);
+        memcpy(t, vt, sizeof(bs256_t) * width);
+    } else {
+        bs_kernel_spec_64(engine, p, t, tw);
+    }
+    
+    for (int group = 0; group < limbs; group++) {
+        size_t offset = (size_t)group * 64;
+        size_t lanes = (count > offset) ? count - offset : 0;
+        if (lanes > 64) lanes = 64;
+        bs_store_group(p, limbs, group, width, plaintexts + offset, lanes);
+        if (tags != NULL) bs_store_group(t, limbs, group, width, tags + offset, lanes);
+    }
+}
+
+typedef void (*bs_spec_fn)(const chilow_engine_t* engine, int limbs, const uint64_t* ciphertexts,
+                           const uint64_t* tweaks, uint64_t* plaintexts, uint64_t* tags, size_t count);
+
+/* ========================================================================== */
+/*                              LANE-PARALLEL ENGINE                         */
+/* ========================================================================== */
+
+/*
+ * Vertical SIMD: every vector lane holds the full word-level state of one block
+ * (plaintext, tag, tweak and a per-block key), so 4 (AVX2) or 8 (AVX-512) blocks
+ * run through the unmodified round structure side by side. Linear layers are the
+ * compile-time shift/mask layers (lane versions of linear_const_*). Kernels are compiled per ISA with
+ * target attributes and selected at runtime; other CPUs use the scalar path.
+ */
+#ifdef CHILOW_HAVE_X86_SIMD
+
+typedef uint64_t lanes4_t __attribute__((vector_size(32)));
+typedef uint64_t lanes8_t __attribute__((vector_size(64)));
+
+/**
+ * Define the lane kernels for one vector type and target ISA
+ */
+#define LANES_DEFINE_KERNELS(NAME, WORD, LANES, TARGET)                                         \
+static inline TARGET WORD lanes_rotr_##NAME(WORD x, int shift, int width) {                     \
+    if (shift == 0) return x;                                                                   \
+    if (width == 64) return (x >> shift) | (x << (64 - shift));                                 \
+    return ((x >> shift) | (x << (width - shift))) & ((1ULL << width) - 1);                     \
+}                                                                                               \
+                                                                                                \
+static inline TARGET WORD lanes_chi_##NAME(WORD x, uint64_t mask, int width) {                  \
+    WORD rot1 = lanes_rotr_##NAME(x, 1, width);                                                 \
+    WORD rot2 = lanes_rotr_##NAME(x, 2, width);                                                 \
+    return (x ^ (~rot1 & rot2)) & mask;                                                         \
+}                                                                                               \
+                                                                                                \
+static inline TARGET WORD lanes_chichi_mix_##NAME(WORD x, int split) {                          \
+    WORD mix = (((x >> split) ^ (x >> (split - 3))) & 1) << (split - 3);                        \
+    mix |= (((x >> (split - 1)) ^ (x >> (split - 2))) & 1) << (split - 2);                      \
+    mix |= (((x >> (split - 3)) ^ (x >> (split - 1)) ^ (x >> split)) & 1) << (split - 1);       \
+    mix |= (((x >> split) ^ (x >> (split - 2))) & 1) << split;                                  \
+    return mix;                                                                                 \
+}                                                                                               \
+                                                                                                \
+static inline TARGET WORD lanes_chichi_##NAME(WORD x, uint64_t small_mask, uint64_t large_mask, \
+                                              int split) {                                      \
+    WORD lower = lanes_chi_##NAME(x & small_mask, small_mask, split - 1);                       \
+    WORD upper = lanes_chi_##NAME((x >> (split - 1)) & large_mask, large_mask, split + 1);      \
+    return ((upper << (split - 1)) | lower) ^ lanes_chichi_mix_##NAME(x, split);                \
+}                                                                                               \
+                                                                                                \
+/* Lane versions of chi_inverse and chichi_inverse (same branch-free candidate selection) */    \
+static inline TARGET WORD lanes_chi_inverse_##NAME(WORD output, uint64_t mask, int width) {     \
+    WORD doubled = output | (output << width);                                                  \
+    WORD acc = ~(doubled >> (width - 2)) & (doubled >> (width - 1));                            \
+    for (int k = width - 4; k >= 1; k -= 2) {                                                   \
+        acc = ~(doubled >> k) & ((doubled >> (k + 1)) ^ acc);                                   \
+    }                                                                                           \
+    return (output ^ acc) & mask;                                                               \
+}                                                                                               \
+                                                                                                \
+static inline TARGET WORD lanes_chichi_inverse_##NAME(WORD output, uint64_t small_mask,         \
+                                                      uint64_t large_mask, int split) {         \
+    WORD lower_out = output & small_mask;                                                       \
+    WORD upper_out = (output >> (split - 1)) & large_mask;                                      \
+    WORD out_bits = (output >> (split - 3)) & 0xF;                                              \
+    WORD lower[4], upper[4], lower_check[4], upper_check[4];                                    \
+    WORD lower_sel = output ^ output, upper_sel = lower_sel;                                    \
+    for (uint64_t v = 0; v < 4; v++) {                                                          \
+        lower[v] = lanes_chi_inverse_##NAME((lower_out & ~(3ULL << (split - 3))) |              \
+                                            (v << (split - 3)), small_mask, split - 1);         \
+        upper[v] = lanes_chi_inverse_##NAME((upper_out & ~3ULL) | v, large_mask, split + 1)     \
+                   << (split - 1);                                                              \
+        lower_check[v] = out_bits ^ v ^ (lanes_chichi_mix_##NAME(lower[v] & (3ULL << (split - 3)), \
+                                                                 split) >> (split - 3));        \
+        upper_check[v] = (v << 2) ^ (lanes_chichi_mix_##NAME(upper[v] & (3ULL << (split - 1)),  \
+                                                             split) >> (split - 3));            \
+    }                                                                                           \
+    for (int a = 0; a < 4; a++) {                                                               \
+        for (int b = 0; b < 4; b++) {                                                           \
+            WORD match = (WORD)(lower_check[a] == upper_check[b]);                              \
+            lower_sel |= lower[a] & match;                                                      \
+            upper_sel |= upper[b] & match;                                                      \
+        }                                                                                       \
+    }                                                                                           \
+    return lower_sel | upper_sel;                                                               \
+}                                                                                               \
+                                                                                                \
+static inline TARGET void lanes_chichi_128_##NAME(WORD* lo, WORD* hi) {                         \
+    WORD in_lo = *lo, in_hi = *hi;                                                              \
+    WORD chi_lower = lanes_chi_##NAME(in_lo & BITMASK_63, BITMASK_63, 63);                      \
+    WORD upper_65 = (in_hi << 1) | ((in_lo >> 63) & 1);                                         \
+    WORD upper_msb = (in_hi >> 63) & 1;                                                         \
+    WORD rot1_val = (upper_msb << 63) | ((upper_65 >> 1) & BITMASK_63);                         \
+    WORD rot1_msb = upper_65 & 1;                                                               \
+    WORD rot2_val = (rot1_msb << 63) | ((rot1_val >> 1) & BITMASK_63);                          \
+    WORD rot2_msb = rot1_val & 1;                                                               \
+    WORD chi_upper_msb = (upper_msb ^ (~rot1_msb & rot2_msb)) & 1;                              \
+    WORD chi_upper_val = upper_65 ^ (~rot1_val & rot2_val);                                     \
+    WORD mix_lo, mix_hi;                                                                        \
+    chi_lower = (chi_lower & BITMASK_63) | ((chi_upper_val & 1) << 63);                         \
+    chi_upper_val = ((chi_upper_val >> 1) & BITMASK_63) | (chi_upper_msb << 63);                \
+    mix_lo = (((in_hi & 1) ^ (in_lo >> 61)) & 1) << 61;                                         \
+    mix_lo |= (((in_lo >> 63) ^ (in_lo >> 62)) & 1) << 62;                                      \
+    mix_lo |= (((in_lo >> 61) ^ (in_lo >> 63) ^ (in_hi & 1)) & 1) << 63;                        \
+    mix_hi = ((in_hi & 1) ^ (in_lo >> 62)) & 1;                                                 \
+    *hi = chi_upper_val ^ mix_hi;                                                               \
+    *lo = chi_lower ^ mix_lo;                                                                   \
+}                                                                                               \
+                                                                                                \
+/* Lane versions of linear_const_64 and linear_const_inv_64 (no tables, no chilow_init()) */    \
+static CONST_INLINE TARGET WORD lanes_permute_const_##NAME(WORD x, int alpha, int beta, int width) { \
+    int period = linear_const_period(alpha, width);                                             \
+    WORD out = x ^ x;                                                                           \
+    for (int row = 0; row < period; row++) {                                                    \
+        int shift = (row - (alpha * row + beta) % width + width) % width;                       \
+        uint64_t mask = 0;                                                                      \
+        for (int r = row; r < width; r += period) mask |= 1ULL << r;                            \
+        out ^= lanes_rotr_##NAME(x, (width - shift) % width, width) & mask;                     \
+    }                                                                                           \
+    return out;                                                                                 \
+}                                                                                               \
+                                                                                                \
+static CONST_INLINE TARGET WORD lanes_linear_const_##NAME(WORD x, const linear_params_t* params, \
+                                                           int width) {                         \
+    WORD z = x ^ lanes_rotr_##NAME(x, (params->beta[1] - params->beta[0] + width) % width, width) \
+               ^ lanes_rotr_##NAME(x, (params->beta[2] - params->beta[0] + width) % width, width); \
+    return lanes_permute_const_##NAME(z, params->alpha[0], params->beta[0], width);             \
+}                                                                                               \
+                                                                                                \
+static CONST_INLINE TARGET WORD lanes_linear_inv_const_##NAME(WORD x, const linear_inv_params_t* inv, \
+                                                               int width) {                     \
+    WORD z = lanes_permute_const_##NAME(x, inv->alpha, inv->beta, width);                       \
+    WORD out = x ^ x;                                                                           \
+    for (int shift = 0; shift < width; shift++) {                                               \
+        if ((inv->taps >> shift) & 1) out ^= lanes_rotr_##NAME(z, (width - shift) % width, width); \
+    }                                                                                           \
+    return out;                                                                                 \
+}                                                                                               \
+                                                                                                \
+static inline TARGET void lanes_rotl_128_##NAME(WORD lo, WORD hi, int shift, WORD* out_lo,      \
+                                                WORD* out_hi) {                                 \
+    if (shift >= 64) {                                                                          \
+        WORD tmp = lo;                                                                          \
+        lo = hi;                                                                                \
+        hi = tmp;                                                                               \
+        shift -= 64;                                                                            \
+    }                                                                                           \
+    if (shift == 0) {                                                                           \
+        *out_lo = lo;                                                                           \
+        *out_hi = hi;                                                                           \
+    } else {                                                                                    \
+        *out_lo = (lo << shift) | (hi >> (64 - shift));                                         \
+        *out_hi = (hi << shift) | (lo >> (64 - shift));                                         \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+/* Lane version of linear_const_128 for the key path */                                         \
+static CONST_INLINE TARGET void lanes_linear_128_const_##NAME(WORD* lo, WORD* hi,               \
+                                                               const linear_params_t* params) { \
+    int period = linear_const_period(params->alpha[0], 128);                                    \
+    WORD z_lo = *lo, z_hi = *hi, r_lo, r_hi;                                                    \
+    WORD out_lo = z_lo ^ z_lo, out_hi = out_lo;                                                 \
+    for (int k = 1; k < 3; k++) {                                                               \
+        lanes_rotl_128_##NAME(*lo, *hi, (128 - (params->beta[k] - params->beta[0] + 128) % 128) % 128, \
+                              &r_lo, &r_hi);                                                    \
+        z_lo ^= r_lo;                                                                           \
+        z_hi ^= r_hi;                                                                           \
+    }                                                                                           \
+    for (int row = 0; row < period; row++) {                                                    \
+        int shift = (row - (params->alpha[0] * row + params->beta[0]) % 128 + 128) % 128;       \
+        uint64_t mask_lo = 0, mask_hi = 0;                                                      \
+        for (int bit = row; bit < 128; bit += period) {                                         \
+            if (bit < 64) {                                                                     \
+                mask_lo |= 1ULL << bit;                                                         \
+            } else {                                                                            \
+                mask_hi |= 1ULL << (bit - 64);                                                  \
+            }                                                                                   \
+        }                                                                                       \
+        lanes_rotl_128_##NAME(z_lo, z_hi, shift, &r_lo, &r_hi);                                 \
+        out_lo ^= r_lo & mask_lo;                                                               \
+        out_hi ^= r_hi & mask_hi;                                                               \
+    }                                                                                           \
+    *lo = out_lo;                                                                               \
+    *hi = out_hi;                                                                               \
+}                                                                                               \
+                                                                                                \
+static TARGET void lanes_decrypt_32_##NAME(const uint32_t* ciphertexts, const uint64_t* tweaks, \
+                                           const uint64_t* keys_hi, const uint64_t* keys_lo,    \
+                                           uint64_t* results) {                                 \
+    uint64_t widened[LANES];                                                                    \
+    WORD p, t, tw, key_lo, key_hi;                                                              \
+    for (int lane = 0; lane < LANES; lane++) widened[lane] = ciphertexts[lane];                 \
+    memcpy(&p, widened, sizeof(WORD));                                                          \
+    memcpy(&tw, tweaks, sizeof(WORD));                                                          \
+    memcpy(&key_lo, keys_lo, sizeof(WORD));                                                     \
+    memcpy(&key_hi, keys_hi, sizeof(WORD));                                                     \
+                                                                                                \
+    /* Initial whitening */                                                                     \
+    t = p ^ ((key_hi >> 32) & BITMASK_32);                                                      \
+    p ^= key_hi & BITMASK_32;                                                                   \
+    tw ^= key_lo;                                                                               \
+                                                                                                \
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {                                      \
+        key_hi ^= ROUND_CONSTANTS[round];                                                       \
+                                                                                                \
+        p = lanes_chichi_##NAME(p, BITMASK_15, BITMASK_17, 16);                                 \
+        t = lanes_chichi_##NAME(t, BITMASK_15, BITMASK_17, 16);                                 \
+        tw = lanes_chichi_##NAME(tw, BITMASK_31, BITMASK_33, 32);                               \
+        lanes_chichi_128_##NAME(&key_lo, &key_hi);                                              \
+                                                                                                \
+        p = lanes_linear_const_##NAME(p, &STATE_PARAMS, 32);                                    \
+        t = lanes_linear_const_##NAME(t, &PRF_PARAMS, 32);                                      \
+        tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                  \
+        lanes_linear_128_const_##NAME(&key_lo, &key_hi, &KEY_PARAMS);                           \
+                                                                                                \
+        p ^= tw & BITMASK_32;                                                                   \
+        t ^= (tw >> 32) & BITMASK_32;                                                           \
+        tw ^= key_lo;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    /* Final round (simplified) */                                                              \
+    p = lanes_chichi_##NAME(p, BITMASK_15, BITMASK_17, 16);                                     \
+    t = lanes_chichi_##NAME(t, BITMASK_15, BITMASK_17, 16);                                     \
+    tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                      \
+    p ^= tw & BITMASK_32;                                                                       \
+    t ^= (tw >> 32) & BITMASK_32;                                                               \
+                                                                                                \
+    p = (t << 32) | (p & BITMASK_32);                                                           \
+    memcpy(results, &p, sizeof(WORD));                                                          \
+}                                                                                               \
+                                                                                                \
+static TARGET void lanes_decrypt_40_##NAME(const uint64_t* ciphertexts, const uint64_t* tweaks, \
+                                           const uint64_t* keys_hi, const uint64_t* keys_lo,    \
+                                           uint64_t* results) {                                 \
+    WORD p, tw, key_lo, key_hi;                                                                 \
+    memcpy(&p, ciphertexts, sizeof(WORD));                                                      \
+    memcpy(&tw, tweaks, sizeof(WORD));                                                          \
+    memcpy(&key_lo, keys_lo, sizeof(WORD));                                                     \
+    memcpy(&key_hi, keys_hi, sizeof(WORD));                                                     \
+                                                                                                \
+    /* Initial whitening */                                                                     \
+    p = (p ^ key_hi) & BITMASK_40;                                                              \
+    tw ^= key_lo;                                                                               \
+                                                                                                \
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {                                      \
+        key_hi ^= ROUND_CONSTANTS_40[round];                                                    \
+                                                                                                \
+        p = lanes_chichi_##NAME(p, BITMASK_19, BITMASK_21, 20);                                 \
+        tw = lanes_chichi_##NAME(tw, BITMASK_31, BITMASK_33, 32);                               \
+        lanes_chichi_128_##NAME(&key_lo, &key_hi);                                              \
+                                                                                                \
+        p = lanes_linear_const_##NAME(p, &STATE40_PARAMS, 40);                                  \
+        tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                  \
+        lanes_linear_128_const_##NAME(&key_lo, &key_hi, &KEY_PARAMS);                           \
+                                                                                                \
+        p ^= tw & BITMASK_40;                                                                   \
+        tw ^= key_lo;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    /* Final round (simplified) */                                                              \
+    p = lanes_chichi_##NAME(p, BITMASK_19, BITMASK_21, 20);                                     \
+    tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                      \
+    p = (p ^ tw) & BITMASK_40;                                                                  \
+    memcpy(results, &p, sizeof(WORD));                                                          \
+}                                                                                               \
+                                                                                                \
+/* Encryption under one key (see encrypt_32_keys): tweak path forward, state path */            \
+/* backwards, then the tag forward from the ciphertext */                                       \
+static TARGET void lanes_encrypt_32_##NAME(const uint32_t* plaintexts, const uint64_t* tweaks,  \
+                                           uint64_t key_hi, uint64_t key_lo,                    \
+                                           const uint64_t* round_keys, uint32_t* ciphertexts,   \
+                                           uint32_t* tags) {                                    \
+    uint64_t widened[LANES];                                                                    \
+    WORD state, tw, t, masks[NUM_ROUNDS];                                                       \
+    for (int lane = 0; lane < LANES; lane++) widened[lane] = plaintexts[lane];                  \
+    memcpy(&state, widened, sizeof(WORD));                                                      \
+    memcpy(&tw, tweaks, sizeof(WORD));                                                          \
+                                                                                                \
+    tw ^= key_lo;                                                                               \
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {                                      \
+        tw = lanes_chichi_##NAME(tw, BITMASK_31, BITMASK_33, 32);                               \
+        tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                  \
+        masks[round] = tw;                                                                      \
+        tw ^= round_keys[round];                                                                \
+    }                                                                                           \
+    masks[NUM_ROUNDS - 1] = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                   \
+                                                                                                \
+    state ^= masks[NUM_ROUNDS - 1] & BITMASK_32;                                                \
+    state = lanes_chichi_inverse_##NAME(state, BITMASK_15, BITMASK_17, 16);                     \
+    for (int round = NUM_ROUNDS - 2; round >= 0; round--) {                                     \
+        state ^= masks[round] & BITMASK_32;                                                     \
+        state = lanes_linear_inv_const_##NAME(state, &STATE_INV_PARAMS, 32);                    \
+        state = lanes_chichi_inverse_##NAME(state, BITMASK_15, BITMASK_17, 16);                 \
+    }                                                                                           \
+    state = (state ^ key_hi) & BITMASK_32;                                                      \
+                                                                                                \
+    t = state ^ ((key_hi >> 32) & BITMASK_32);                                                  \
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {                                      \
+        t = lanes_chichi_##NAME(t, BITMASK_15, BITMASK_17, 16);                                 \
+        t = lanes_linear_const_##NAME(t, &PRF_PARAMS, 32);                                      \
+        t ^= (masks[round] >> 32) & BITMASK_32;                                                 \
+    }                                                                                           \
+    t = lanes_chichi_##NAME(t, BITMASK_15, BITMASK_17, 16);                                     \
+    t ^= (masks[NUM_ROUNDS - 1] >> 32) & BITMASK_32;                                            \
+                                                                                                \
+    memcpy(widened, &state, sizeof(WORD));                                                      \
+    for (int lane = 0; lane < LANES; lane++) ciphertexts[lane] = (uint32_t)widened[lane];       \
+    memcpy(widened, &t, sizeof(WORD));                                                          \
+    for (int lane = 0; lane < LANES; lane++) tags[lane] = (uint32_t)widened[lane];              \
+}                                                                                               \
+                                                                                                \
+/* 40-bit encryption under one key (see encrypt_40_keys) */                                     \
+static TARGET void lanes_encrypt_40_##NAME(const uint64_t* plaintexts, const uint64_t* tweaks,  \
+                                           uint64_t key_hi, uint64_t key_lo,                    \
+                                           const uint64_t* round_keys, uint64_t* ciphertexts) { \
+    WORD state, tw, masks[NUM_ROUNDS];                                                          \
+    memcpy(&state, plaintexts, sizeof(WORD));                                                   \
+    memcpy(&tw, tweaks, sizeof(WORD));                                                          \
+                                                                                                \
+    tw ^= key_lo;                                                                               \
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {                                      \
+        tw = lanes_chichi_##NAME(tw, BITMASK_31, BITMASK_33, 32);                               \
+        tw = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                                  \
+        masks[round] = tw;                                                                      \
+        tw ^= round_keys[round];                                                                \
+    }                                                                                           \
+    masks[NUM_ROUNDS - 1] = lanes_linear_const_##NAME(tw, &TWEAK_PARAMS, 64);                   \
+                                                                                                \
+    state = (state ^ masks[NUM_ROUNDS - 1]) & BITMASK_40;                                       \
+    state = lanes_chichi_inverse_##NAME(state, BITMASK_19, BITMASK_21, 20);                     \
+    for (int round = NUM_ROUNDS - 2; round >= 0; round--) {                                     \
+        state ^= masks[round] & BITMASK_40;                                                     \
+        state = lanes_linear_inv_const_##NAME(state, &STATE40_INV_PARAMS, 40);                  \
+        state = lanes_chichi_inverse_##NAME(state, BITMASK_19, BITMASK_21, 20);                 \
+    }                                                                                           \
+    state = (state ^ key_hi) & BITMASK_40;                                                      \
+    memcpy(ciphertexts, &state, sizeof(WORD));                                                  \
+}
+
+LANES_DEFINE_KERNELS(avx2, lanes4_t, 4, __attribute__((target("avx2"))))
+LANES_DEFINE_KERNELS(avx512, lanes8_t, 8, __attribute__((target("avx512f"))))
+
+#endif /* CHILOW_HAVE_X86_SIMD */
+
+/**
+ * Number of blocks the lane-parallel engine handles per step on this CPU
+ * (1 means no supported vector ISA: the scalar path is used)
+ */
+static inline int lanes_per_step(void) {
+#ifdef CHILOW_HAVE_X86_SIMD
+    if (__builtin_cpu_supports("avx512f")) return 8;
+    if (__builtin_cpu_supports("avx2")) return 4;
+#endif
+    return 1;
+}
+
+/* ========================================================================== */
+/*                              RUNTIME KERNEL DISPATCH                      */
+/* ========================================================================== */
+
+/*
+ * chilow_decrypt_32bit/40bit and the bitsliced batch API go through a table of
+ * kernels, each compiled from the same engine with a different target attribute.
+ * chilow_init() picks the best one the CPU supports; CHILOW_KERNEL=<name> in the
+ * environment forces one (for A/B runs). Builds with -march=native gain little from
+ * this, but a portable build (make lib) gets BMI2/AVX2/AVX-512 code paths.
+ */
+typedef struct {
+    const char* name;
+    int (*supported)(void);
+    uint64_t (*decrypt_32)(uint32_t ciphertext, uint64_t tweak, uint128_t key);
+    uint64_t (*decrypt_40)(uint64_t ciphertext, uint64_t tweak, uint128_t key);
+    bs_chunk_fn bs_chunk;
+    bs_verify_fn bs_verify;
+    bs_spec_fn bs_spec;
+    bs_cube_fn bs_cube;
+} kernel_table_t;
+
+/**
+ * Define the kernels for one target ISA
+ */
+#define KERNEL_DEFINE(NAME, TARGET)                                                             \
+static TARGET uint64_t kernel_decrypt_32_##NAME(uint32_t ciphertext, uint64_t tweak,            \
+                                                uint128_t key) {                                \
+    return engine_decrypt_32(ciphertext, tweak, key, NULL, NUM_ROUNDS - 1, FINAL_ROUND_FULL,    \
+                             NULL, NULL);                                                       \
+}                                                                                               \
+                                                                                                \
+static TARGET uint64_t kernel_decrypt_40_##NAME(uint64_t ciphertext, uint64_t tweak,            \
+                                                uint128_t key) {                                \
+    return engine_decrypt_40(ciphertext, tweak, key, NULL, NUM_ROUNDS - 1, FINAL_ROUND_FULL,    \
+                             NULL, NULL);                                                       \
+}                                                                                               \
+                                                                                                \
+static TARGET void kernel_bs_chunk_##NAME(int variant_40, int limbs,                            \
+                                          const uint32_t* ciphertexts_32,                       \
+                                          const uint64_t* ciphertexts_40,                       \
+                                          const uint64_t* tweaks, uint64_t key_hi,              \
+                                          uint64_t key_lo, const uint64_t* round_keys,          \
+                                          int num_rounds, int final_round, uint64_t* results,   \
+                                          size_t count) {                                       \
+    bs_decrypt_chunk(variant_40, limbs, ciphertexts_32, ciphertexts_40, tweaks, key_hi, key_lo, \
+                     round_keys, num_rounds, final_round, results, count);                      \
+}                                                                                               \
+                                                                                                \
+static TARGET void kernel_bs_verify_##NAME(int limbs, const uint32_t* ciphertexts,              \
+                                           const uint64_t* tweaks, const uint32_t* tags,        \
+                                           uint64_t key_hi, uint64_t key_lo,                    \
+                                           const uint64_t* round_keys, uint64_t* bitmap,        \
+                                           uint32_t* plaintexts, size_t count) {                \
+    bs_verify_chunk(limbs, ciphertexts, tweaks, tags, key_hi, key_lo, round_keys, bitmap,       \
+                    plaintexts, count);                                                         \
+}                                                                                               \
+                                                                                                \
+static TARGET void kernel_bs_spec_##NAME(const chilow_engine_t* engine, int limbs,              \
+                                         const uint64_t* ciphertexts, const uint64_t* tweaks,   \
+                                         uint64_t* plaintexts, uint64_t* tags, size_t count) {  \
+    bs_spec_chunk(engine, limbs, ciphertexts, tweaks, plaintexts, tags, count);                 \
+}                                                                                               \
+                                                                                                \
+static TARGET void kernel_bs_cube_##NAME(int variant_40, int limbs, uint64_t* slices,           \
+                                         uint64_t key_hi, const uint64_t* masks, int num_rounds, \
+                                         int every_round, const uint64_t* lane_masks,           \
+                                         uint64_t* acc) {                                       \
+    bs_cube_chunk(variant_40, limbs, slices, key_hi, masks, num_rounds, every_round,            \
+                  lane_masks, acc);                                                             \
+}
+
+static int kernel_supported_scalar(void) {
+    return 1;
+}
+
+KERNEL_DEFINE(scalar, )
+
+#ifdef CHILOW_HAVE_X86_SIMD
+KERNEL_DEFINE(bmi2, __attribute__((target("bmi,bmi2"))))
+KERNEL_DEFINE(avx2, __attribute__((target("avx2,bmi,bmi2"))))
+KERNEL_DEFINE(avx512, __attribute__((target("avx512f,avx512vl,avx512bw,bmi,bmi2"))))
+
+static int kernel_supported_bmi2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+}
+
+static int kernel_supported_avx2(void) {
+    return kernel_supported_bmi2() && __builtin_cpu_supports("avx2");
+}
+
+static int kernel_supported_avx512(void) {
+    return kernel_supported_avx2() && __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw");
+}
+#endif
+
+/* Ordered from least to most capable; the last supported entry is the default */
+static const kernel_table_t KERNELS[] = {
+    {"scalar", kernel_supported_scalar, kernel_decrypt_32_scalar, kernel_decrypt_40_scalar,
+     kernel_bs_chunk_scalar, kernel_bs_verify_scalar, kernel_bs_spec_scalar, kernel_bs_cube_scalar},
+#ifdef CHILOW_HAVE_X86_SIMD
+    {"bmi2", kernel_supported_bmi2, kernel_decrypt_32_bmi2, kernel_decrypt_40_bmi2,
+     kernel_bs_chunk_bmi2, kernel_bs_verify_bmi2, kernel_bs_spec_bmi2, kernel_bs_cube_bmi2},
+    {"avx2", kernel_supported_avx2, kernel_decrypt_32_avx2, kernel_decrypt_40_avx2,
+     kernel_bs_chunk_avx2, kernel_bs_verify_avx2, kernel_bs_spec_avx2, kernel_bs_cube_avx2},
+    {"avx512", kernel_supported_avx512, kernel_decrypt_32_avx512, kernel_decrypt_40_avx512,
+     kernel_bs_chunk_avx512, kernel_bs_verify_avx512, kernel_bs_spec_avx512, kernel_bs_cube_avx512},
+#endif
+};
+
+#define NUM_KERNELS ((int)(sizeof(KERNELS) / sizeof(KERNELS[0])))
+
+/* Scalar until chilow_init() has run */
+static const kernel_table_t* kernel_active = &KERNELS[0];
+
+/**
+ * Find a kernel by name; NULL if unknown or unsupported on this CPU
+ */
+static const kernel_table_t* kernel_find(const char* name) {
+    for (int i = 0; i < NUM_KERNELS; i++) {
+        if (strcmp(KERNELS[i].name, name) == 0) {
+            return KERNELS[i].supported() ? &KERNELS[i] : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Select the best supported kernel, or the one named by $CHILOW_KERNEL
+ */
+static void kernel_select(void) {
+    const char* forced = getenv("CHILOW_KERNEL");
+    
+    for (int i = 0; i < NUM_KERNELS; i++) {
+        if (KERNELS[i].supported()) kernel_active = &KERNELS[i];
+    }
+    if (forced != NULL && forced[0] != '\0') {
+        const kernel_table_t* kernel = kernel_find(forced);
+        if (kernel != NULL) {
+            kernel_active = kernel;
+        } else {
+            fprintf(stderr, "chilow: CHILOW_KERNEL=%s is unknown or unsupported, using %s\n",
+                    forced, kernel_active->name);
+        }
+    }
+}
+
+/* ========================================================================== */
+/*                              THREADED BULK DECRYPTION                     */
+/* ========================================================================== */
+
+/*
+ * chilow_decrypt_{32,40}bit_bulk split an array over a persistent worker pool. Work is
+ * handed out in chunks of BULK_CHUNK_BLOCKS blocks, a multiple of the 512-lane bitsliced
+ * batch and of a cache line of inputs and outputs, so threads never write to the same
+ * line of `results` and every chunk but the last runs on the widest engine. Workers are
+ * created on first use, added when a call asks for more, and park on a condition
+ * variable between calls; the calling thread takes chunks as well.
+ */
+#define BULK_CHUNK_BLOCKS 4096
+#define BULK_MAX_THREADS 64
+
+typedef struct {
+    int variant_40;
+    const uint32_t* ciphertexts_32;
+    const uint64_t* ciphertexts_40;
+    const uint64_t* tweaks;
+    const chilow_ctx_t* ctx;
+    uint64_t* results;
+    size_t num_blocks;
+} bulk_job_t;
+
+/**
+ * Decrypt blocks [start, start + count) of a job with the context's round keys
+ */
+static void bulk_run_range(const bulk_job_t* job, size_t start, size_t count) {
+    const chilow_ctx_t* ctx = job->ctx;
+    
+    bs_decrypt_range(kernel_active->bs_chunk, job->variant_40,
+                     job->ciphertexts_32 ? job->ciphertexts_32 + start : NULL,
+                     job->ciphertexts_40 ? job->ciphertexts_40 + start : NULL,
+                     job->tweaks + start, ctx->key_hi, ctx->key_lo,
+                     job->variant_40 ? ctx->round_keys_40 : ctx->round_keys_32,
+                     NUM_ROUNDS - 1, FINAL_ROUND_FULL, job->results + start, count);
+}
+
+#ifdef CHILOW_HAVE_PTHREADS
+
+static struct {
+    pthread_mutex_t submit;          /* one bulk call at a time */
+    pthread_mutex_t lock;            /* guards the fields below */
+    pthread_cond_t work;             /* generation changed or shutdown requested */
+    pthread_cond_t done;             /* busy dropped to 0 */
+    pthread_t threads[BULK_MAX_THREADS];
+    int num_threads;
+    int participants;                /* workers with index < participants join the job */
+    int busy;                        /* participants still working on the job */
+    int shutdown;
+    unsigned long generation;
+    const bulk_job_t* job;
+    size_t next;                     /* first unclaimed block */
+} bulk_pool = {.submit = PTHREAD_MUTEX_INITIALIZER, .lock = PTHREAD_MUTEX_INITIALIZER,
+               .work = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER};
+
+/**
+ * Claim and decrypt chunks until the job is exhausted (called with the lock held)
+ */
+static void bulk_work_locked(void) {
+    const bulk_job_t* job = bulk_pool.job;
+    
+    while (bulk_pool.next < job->num_blocks) {
+        size_t start = bulk_pool.next;
+        size_t remaining = job->num_blocks - start;
+        size_t count = remaining < BULK_CHUNK_BLOCKS ? remaining : BULK_CHUNK_BLOCKS;
+        
+        bulk_pool.next += count;
+        pthread_mutex_unlock(&bulk_pool.lock);
+        bulk_run_range(job, start, count);
+        pthread_mutex_lock(&bulk_pool.lock);
+    }
+}
+
+static void* bulk_worker(void* arg) {
+    int index = (int)(intptr_t)arg;
+    unsigned long seen = 0;
+    
+    pthread_mutex_lock(&bulk_pool.lock);
+    for (;;) {
+        while (!bulk_pool.shutdown && bulk_pool.generation == seen) {
+            pthread_cond_wait(&bulk_pool.work, &bulk_pool.lock);
+        }
+        if (bulk_pool.shutdown) break;
+        seen = bulk_pool.generation;
+        if (index >= bulk_pool.participants) continue;
+        
+        bulk_work_locked();
+        if (--bulk_pool.busy == 0) pthread_cond_signal(&bulk_pool.done);
+    }
+    pthread_mutex_unlock(&bulk_pool.lock);
+    return NULL;
+}
+
+/**
+ * Run a job on the calling thread plus up to threads - 1 pool workers
+ */
+static void bulk_decrypt(const bulk_job_t* job, int threads) {
+    size_t chunks = (job->num_blocks + BULK_CHUNK_BLOCKS - 1) / BULK_CHUNK_BLOCKS;
+    
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+    if (threads > BULK_MAX_THREADS) threads = BULK_MAX_THREADS;
+    if ((size_t)threads > chunks) threads = (int)chunks;
+    if (threads <= 1) {
+        bulk_run_range(job, 0, job->num_blocks);
+        return;
+    }
+    
+    pthread_mutex_lock(&bulk_pool.submit);
+    pthread_mutex_lock(&bulk_pool.lock);
+    while (bulk_pool.num_threads < threads - 1) {
+        int index = bulk_pool.num_threads;
+        if (pthread_create(&bulk_pool.threads[index], NULL, bulk_worker, (void*)(intptr_t)index) != 0) {
+            break;  /* run with the workers we have */
+        }
+        bulk_pool.num_threads++;
+    }
+    
+    bulk_pool.job = job;
+    bulk_pool.next = 0;
+    bulk_pool.participants = threads - 1 < bulk_pool.num_threads ? threads - 1 : bulk_pool.num_threads;
+    bulk_pool.busy = bulk_pool.participants;
+    bulk_pool.generation++;
+    pthread_cond_broadcast(&bulk_pool.work);
+    
+    bulk_work_locked();
+    while (bulk_pool.busy > 0) {
+        pthread_cond_wait(&bulk_pool.done, &bulk_pool.lock);
+    }
+    bulk_pool.job = NULL;
+    pthread_mutex_unlock(&bulk_pool.lock);
+    pthread_mutex_unlock(&bulk_pool.submit);
+}
+
+/**
+ * Stop and join all pool workers
+ */
+static void bulk_shutdown(void) {
+    pthread_mutex_lock(&bulk_pool.submit);
+    pthread_mutex_lock(&bulk_pool.lock);
+    bulk_pool.shutdown = 1;
+    pthread_cond_broadcast(&bulk_pool.work);
+    pthread_mutex_unlock(&bulk_pool.lock);
+    
+    for (int i = 0; i < bulk_pool.num_threads; i++) {
+        pthread_join(bulk_pool.threads[i], NULL);
+    }
+    bulk_pool.num_threads = 0;
+    bulk_pool.shutdown = 0;
+    pthread_mutex_unlock(&bulk_pool.submit);
+}
+
+#else
+
+static void bulk_decrypt(const bulk_job_t* job, int threads) {
+    (void)threads;
+    bulk_run_range(job, 0, job->num_blocks);
+}
+
+static void bulk_shutdown(void) {
+}
+
+#endif /* CHILOW_HAVE_PTHREADS */
+
+/* ========================================================================== */
+/*                              STRIDED BATCH                                */
+/* ========================================================================== */
+
+/*
+ * Strided batches read fields straight out of caller records. Each tile of
+ * STRIDED_TILE_BLOCKS records is gathered into small contiguous arrays (about 20 KB,
+ * so they stay in L1/L2), decrypted with the bitsliced engine (shared key) or the
+ * lane-parallel engine (per-record keys), and scattered back. The buffer is read and
+ * written once. A tile is fully gathered before anything is written, so the output
+ * field may overlap the input fields of the same records (in-place decryption).
+ */
+#define STRIDED_TILE_BLOCKS 512
+
+static inline uint64_t strided_load_64(const void* base, size_t stride, size_t index) {
+    uint64_t value;
+    memcpy(&value, (const unsigned char*)base + index * stride, sizeof value);
+    return value;
+}
+
+static inline uint32_t strided_load_32(const void* base, size_t stride, size_t index) {
+    uint32_t value;
+    memcpy(&value, (const unsigned char*)base + index * stride, sizeof value);
+    return value;
+}
+
+static inline void strided_store_64(void* base, size_t stride, size_t index, uint64_t value) {
+    memcpy((unsigned char*)base + index * stride, &value, sizeof value);
+}
+
+static void strided_decrypt(int variant_40, const chilow_strided_t* batch, size_t num_blocks) {
+    uint32_t c32[STRIDED_TILE_BLOCKS];
+    uint64_t c40[STRIDED_TILE_BLOCKS], tweaks[STRIDED_TILE_BLOCKS], results[STRIDED_TILE_BLOCKS];
+    uint64_t keys_hi[STRIDED_TILE_BLOCKS], keys_lo[STRIDED_TILE_BLOCKS];
+    uint64_t round_keys[NUM_ROUNDS];
+    uint64_t key_hi = 0, key_lo = 0;
+    int shared_key = batch->key_stride == 0;
+    
+    if (num_blocks == 0) return;
+    if (shared_key) {
+        uint128_t key;
+        key_hi = strided_load_64(batch->keys_hi, 0, 0);
+        key_lo = strided_load_64(batch->keys_lo, 0, 0);
+        key.lo = key_lo;
+        key.hi = key_hi;
+        expand_round_keys(key, variant_40 ? ROUND_CONSTANTS_40 : ROUND_CONSTANTS, NUM_ROUNDS - 1,
+                          round_keys);
+    }
+    
+    for (size_t start = 0; start < num_blocks; start += STRIDED_TILE_BLOCKS) {
+        size_t count = num_blocks - start < STRIDED_TILE_BLOCKS ? num_blocks - start : STRIDED_TILE_BLOCKS;
+        
+        for (size_t i = 0; i < count; i++) {
+            if (variant_40) {
+                c40[i] = strided_load_64(batch->ciphertexts, batch->ciphertext_stride, start + i);
+            } else {
+                c32[i] = strided_load_32(batch->ciphertexts, batch->ciphertext_stride, start + i);
+            }
+            tweaks[i] = strided_load_64(batch->tweaks, batch->tweak_stride, start + i);
+            if (!shared_key) {
+                keys_hi[i] = strided_load_64(batch->keys_hi, batch->key_stride, start + i);
+                keys_lo[i] = strided_load_64(batch->keys_lo, batch->key_stride, start + i);
+            }
+        }
+        
+        if (shared_key) {
+            bs_decrypt_range(kernel_active->bs_chunk, variant_40, variant_40 ? NULL : c32,
+                             variant_40 ? c40 : NULL, tweaks, key_hi, key_lo, round_keys,
+                             NUM_ROUNDS - 1, FINAL_ROUND_FULL, results, count);
+        } else if (variant_40) {
+            chilow_decrypt_40bit_lanes(c40, tweaks, keys_hi, keys_lo, results, count);
+        } else {
+            chilow_decrypt_32bit_lanes(c32, tweaks, keys_hi, keys_lo, results, count);
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            strided_store_64(batch->results, batch->result_stride, start + i, results[i]);
+        }
+    }
+}
+
+/* ========================================================================== */
+/*                              MEMORY ENCRYPTION                            */
+/* ========================================================================== */
+
+/*
+ * Buffers of 32-bit words at a (virtual or physical) address. Word i is bound to its
+ * own address through the tweak (see chilow_memory_tweak), and its 32-bit tag goes to a
+ * parallel array. Tweaks are derived per tile of MEMORY_TILE_WORDS words. Encryption runs
+ * the lane-parallel kernels (8 words per step with AVX-512, 4 with AVX2), and decryption
+ * runs the bitsliced tag-verification kernel, both under the context's round keys.
+ */
+#define MEMORY_TILE_WORDS 512
+
+static void memory_tweaks(uint64_t address, size_t first, uint64_t domain, uint64_t* tweaks,
+                          size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        tweaks[i] = chilow_memory_tweak(address, first + i, domain);
+    }
+}
+
+static void memory_encrypt_tile(const chilow_ctx_t* ctx, const uint32_t* plaintexts,
+                                const uint64_t* tweaks, uint32_t* ciphertexts, uint32_t* tags,
+                                size_t count) {
+    uint128_t key = {ctx->key_lo, ctx->key_hi};
+    size_t i = 0;
+    
+#ifdef CHILOW_HAVE_X86_SIMD
+    size_t step = (size_t)lanes_per_step();
+    for (; step > 1 && i + step <= count; i += step) {
+        if (step == 8) {
+            lanes_encrypt_32_avx512(plaintexts + i, tweaks + i, ctx->key_hi, ctx->key_lo,
+                                    ctx->round_keys_32, ciphertexts + i, tags + i);
+        } else {
+            lanes_encrypt_32_avx2(plaintexts + i, tweaks + i, ctx->key_hi, ctx->key_lo,
+                                  ctx->round_keys_32, ciphertexts + i, tags + i);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        uint64_t result = encrypt_32_keys(plaintexts[i], tweaks[i], key, ctx->round_keys_32);
+        ciphertexts[i] = (uint32_t)result;
+        tags[i] = (uint32_t)(result >> 32);
+    }
+}
+
+/* ========================================================================== */
+/*                              POINTER AUTHENTICATION                       */
+/* ========================================================================== */
+
+/*
+ * ChiLow-40 over the low 40 bits of 64-bit pointers (see chilow_pac_t). Bits 40..63 of a
+ * signed pointer, including the check field, are XORed into the caller's context to form
+ * the tweak, so changing them garbles the decrypted address. Batches are processed in
+ * tiles of PAC_TILE_POINTERS: signing on the lane-parallel encryption kernels,
+ * authentication on the bitsliced 40-bit engine, both under the context's round keys.
+ */
+#define PAC_TILE_POINTERS 512
+
+static void pac_sign_tile(const chilow_ctx_t* ctx, const uint64_t* addresses, const uint64_t* tweaks,
+                          uint64_t* ciphertexts, size_t count) {
+    uint128_t key = {ctx->key_lo, ctx->key_hi};
+    size_t i = 0;
+    
+#ifdef CHILOW_HAVE_X86_SIMD
+    size_t step = (size_t)lanes_per_step();
+    for (; step > 1 && i + step <= count; i += step) {
+        if (step == 8) {
+            lanes_encrypt_40_avx512(addresses + i, tweaks + i, ctx->key_hi, ctx->key_lo,
+                                    ctx->round_keys_40, ciphertexts + i);
+        } else {
+            lanes_encrypt_40_avx2(addresses + i, tweaks + i, ctx->key_hi, ctx->key_lo,
+                                  ctx->round_keys_40, ciphertexts + i);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        ciphertexts[i] = encrypt_40_keys(addresses[i], tweaks[i], key, ctx->round_keys_40);
+    }
+}
+
+/* ========================================================================== */
+/*                              COUNTER-MODE PRF                             */
+/* ========================================================================== */
+
+/*
+ * Keystream from the tag half of ChiLow-(32+tau), a keyed PRF of (ciphertext, tweak).
+ * Block b (4 output bytes, little-endian tag) evaluates the PRF at ciphertext (uint32_t)b
+ * and tweak (nonce << 32) | (b >> 32), so streams of distinct nonces never share an
+ * input. Consecutive blocks are evaluated PRF_TILE_BLOCKS at a time on the bitsliced
+ * engine under the context's round keys.
+ */
+#define PRF_TILE_BLOCKS 512
+
+static void prf_tile(const chilow_ctx_t* ctx, uint32_t nonce, uint64_t first_block, uint64_t* results,
+                     size_t count) {
+    uint32_t counters[PRF_TILE_BLOCKS];
+    uint64_t tweaks[PRF_TILE_BLOCKS];
+    
+    for (size_t i = 0; i < count; i++) {
+        uint64_t block = first_block + i;
+        counters[i] = (uint32_t)block;
+        tweaks[i] = ((uint64_t)nonce << 32) | (block >> 32);
+    }
+    bs_decrypt_range(kernel_active->bs_chunk, 0, counters, NULL, tweaks, ctx->key_hi, ctx->key_lo,
+                     ctx->round_keys_32, NUM_ROUNDS - 1, FINAL_ROUND_FULL, results, count);
+}
+
+/* ========================================================================== */
+/*                              CUBE ENUMERATION                             */
+/* ========================================================================== */
+
+/*
+ * deposit(value, mask): the low popcount(mask) bits of value placed at the set bits of
+ * mask, lowest first. Every kernel above scalar requires BMI2, so the active kernel
+ * decides between PDEP and the bit loop (chilow_set_kernel("scalar") forces the loop).
+ */
+static uint64_t cube_deposit_scalar(uint64_t value, uint64_t mask) {
+    uint64_t result = 0;
+    
+    for (; mask != 0; value >>= 1) {
+        result |= mask & (0 - mask) & (0 - (value & 1));
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+#ifdef CHILOW_HAVE_X86_SIMD
+__attribute__((target("bmi2")))
+static uint64_t cube_deposit_bmi2(uint64_t value, uint64_t mask) {
+    return _pdep_u64(value, mask);
+}
+#endif
+
+static uint64_t cube_deposit(uint64_t value, uint64_t mask) {
+#ifdef CHILOW_HAVE_X86_SIMD
+    if (kernel_active != &KERNELS[0]) return cube_deposit_bmi2(value, mask);
+#endif
+    return cube_deposit_scalar(value, mask);
+}
+
+/**
+ * Run the key and tweak paths of a cube once (see chilow_integral_t)
+ */
+static void integral_schedule(chilow_integral_t* integral, int variant_40, uint64_t tweak, uint64_t key_hi,
+                              uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t round_keys[NUM_ROUNDS];
+    
+    expand_round_keys(key, variant_40 ? ROUND_CONSTANTS_40 : ROUND_CONSTANTS, NUM_ROUNDS, round_keys);
+    tweak_round_masks(key_lo, tweak, round_keys, NUM_ROUNDS, integral->masks);
+    integral->key_hi = key_hi;
+}
+
+/**
+ * Lanes lo .. hi - 1 of a 64-lane group (empty if hi <= lo)
+ */
+static uint64_t cube_lane_mask(int64_t lo, int64_t hi) {
+    if (lo < 0) lo = 0;
+    if (hi > 64) hi = 64;
+    if (hi <= lo) return 0;
+    return ((hi == 64) ? ~0ULL : (1ULL << hi) - 1) & ~((1ULL << lo) - 1);
+}
+
+/**
+ * XOR of the num_rounds complete-round outputs of cube elements first .. first + count - 1
+ * (clipped to the cube) on the active bitsliced kernel, see bs_cube_chunk. A non-NULL sums
+ * receives the sum for every round count 0 .. num_rounds from the same passes.
+ */
+static uint64_t cube_sum(int variant_40, const chilow_cube_t* cube, uint64_t first, uint64_t count,
+                         uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds, uint64_t* sums) {
+    uint64_t slices[64 * BS_MAX_LIMBS], acc[64 * (NUM_ROUNDS + 1)] = {0}, end;
+    int every_round = (sums != NULL);
+    chilow_integral_t integral;
+    
+    num_rounds = clamp_rounds(num_rounds);
+    if (sums != NULL) memset(sums, 0, sizeof(uint64_t) * (size_t)(num_rounds + 1));
+    if (first >= cube->size) return 0;
+    end = (count > cube->size - first) ? cube->size : first + count;
+    integral_schedule(&integral, variant_40, tweak, key_hi, key_lo);
+    
+    while (first < end) {
+        uint64_t remaining = end - first;
+        int limbs = (remaining >= 512) ? 8 : (remaining >= 256) ? 4 : 1;
+        uint64_t start = first & ~((uint64_t)limbs * 64 - 1);
+        uint64_t stop = (end - start < (uint64_t)limbs * 64) ? end : start + (uint64_t)limbs * 64;
+        uint64_t lane_masks[BS_MAX_LIMBS];
+        
+        for (int group = 0; group < limbs; group++) {
+            lane_masks[group] = cube_lane_mask((int64_t)(first - start) - 64 * group,
+                                               (int64_t)(stop - start) - 64 * group);
+        }
+        bs_cube_slices(cube, limbs, start, slices);
+        kernel_active->bs_cube(variant_40, limbs, slices, integral.key_hi, integral.masks, num_rounds,
+                               every_round, lane_masks, acc);
+        first = stop;
+    }
+    for (int rounds = every_round ? 0 : num_rounds; rounds <= num_rounds; rounds++) {
+        const uint64_t* round_acc = every_round ? acc + 64 * rounds : acc;
+        uint64_t sum = 0;
+        for (int bit = 0; bit < 64; bit++) {
+            sum |= (uint64_t)(popcount64(round_acc[bit]) & 1) << bit;
+        }
+        if (!every_round) return sum;
+        sums[rounds] = sum;
+    }
+    return sums[num_rounds];
+}
+
+/* ========================================================================== */
+/*                              KEY-SPECIALIZED JIT                          */
+/* ========================================================================== */
+
+#ifdef CHILOW_JIT
+
+/* Bump when the generated source changes, so stale cached kernels are not reused */
+#define CHILOW_JIT_VERSION 1
+
+#ifndef CHILOW_JIT_CC
+#define CHILOW_JIT_CC "gcc"
+#endif
+#ifndef CHILOW_JIT_CFLAGS
+#define CHILOW_JIT_CFLAGS "-std=c99 -O3 -march=native"
+#endif
+
+/* Blocks cross-checked against chilow_decrypt_32bit before a kernel is used */
+#define CHILOW_JIT_VERIFY_BLOCKS 256
+
+/* Longest cache path accepted (a longer one makes chilow_jit_init fail) */
+#define JIT_PATH_MAX 4096
+
+/* Most compiler arguments taken from CHILOW_JIT_CC and CHILOW_JIT_CFLAGS together */
+#define JIT_MAX_ARGS 64
+
+/**
+ * Generated-source prelude: rotations and chi on native 32-bit words for the state and
+ * tag (which lets the batch loop vectorize) and 64-bit words for the tweak
+ */
+static const char JIT_PRELUDE[] =
+    "#include <stdint.h>\n"
+    "\n"
+    "static inline uint32_t rotl32(uint32_t v, int s) { return (v << s) | (v >> (32 - s)); }\n"
+    "static inline uint64_t rotl64(uint64_t v, int s) { return (v << s) | (v >> (64 - s)); }\n"
+    "\n"
+    "static inline uint32_t chi32(uint32_t x, uint32_t mask, int n) {\n"
+    "    uint32_t r1 = ((x >> 1) | (x << (n - 1))) & mask;\n"
+    "    uint32_t r2 = ((x >> 2) | (x << (n - 2))) & mask;\n"
+    "    return (x ^ (~r1 & r2)) & mask;\n"
+    "}\n"
+    "\n"
+    "static inline uint64_t chi64(uint64_t x, uint64_t mask, int n) {\n"
+    "    uint64_t r1 = ((x >> 1) | (x << (n - 1))) & mask;\n"
+    "    uint64_t r2 = ((x >> 2) | (x << (n - 2))) & mask;\n"
+    "    return (x ^ (~r1 & r2)) & mask;\n"
+    "}\n";
+
+/**
+ * Emit chichi for one split position with every shift and mask written out
+ * (see chichi_transform and chichi_mix)
+ */
+static void jit_emit_chichi(FILE* out, const char* name, int width, int split_pos) {
+    const char* type = (width == 32) ? "uint32_t" : "uint64_t";
+    const char* suffix = (width == 32) ? "U" : "ULL";
+    unsigned long long small_mask = (1ULL << (split_pos - 1)) - 1;
+    unsigned long long large_mask = (1ULL << (split_pos + 1)) - 1;
+    int s = split_pos;
+    
+    fprintf(out, "\nstatic inline %s %s(%s x) {\n", type, name, type);
+    fprintf(out, "    %s lo = chi%d(x & 0x%llX%s, 0x%llX%s, %d);\n", type, width, small_mask, suffix, small_mask, suffix, s - 1);
+    fprintf(out, "    %s hi = chi%d((x >> %d) & 0x%llX%s, 0x%llX%s, %d);\n", type, width, s - 1, large_mask, suffix, large_mask, suffix, s + 1);
+    fprintf(out, "    %s mix = 0;\n", type);
+    fprintf(out, "    mix |= (((x >> %d) ^ (x >> %d)) & 1) << %d;\n", s, s - 3, s - 3);
+    fprintf(out, "    mix |= (((x >> %d) ^ (x >> %d)) & 1) << %d;\n", s - 1, s - 2, s - 2);
+    fprintf(out, "    mix |= (((x >> %d) ^ (x >> %d) ^ (x >> %d)) & 1) << %d;\n", s - 3, s - 1, s, s - 1);
+    fprintf(out, "    mix |= (((x >> %d) ^ (x >> %d)) & 1) << %d;\n", s, s - 2, s);
+    fprintf(out, "    return ((hi << %d) | lo) ^ mix;\n", s - 1);
+    fprintf(out, "}\n");
+}
+
+/**
+ * Emit a 32- or 64-bit linear layer as a C function of rotations and masks, grouped
+ * as in linear_const_64 (rows with the same rotation share one mask)
+ */
+static void jit_emit_linear(FILE* out, const char* name, const linear_params_t* params, int width) {
+    const char* type = (width == 32) ? "uint32_t" : "uint64_t";
+    const char* suffix = (width == 32) ? "U" : "ULL";
+    uint64_t masks[64];
+    
+    memset(masks, 0, sizeof(masks));
+    for (int row = 0; row < width; row++) {
+        masks[(row - (params->alpha[0] * row + params->beta[0]) % width + width) % width] |= 1ULL << row;
+    }
+    fprintf(out, "\nstatic inline %s %s(%s x) {\n", type, name, type);
+    fprintf(out, "    %s z = x", type);
+    for (int k = 1; k < 3; k++) {
+        int shift = (width - (params->beta[k] - params->beta[0] + width) % width) % width;
+        if (shift != 0) fprintf(out, " ^ rotl%d(x, %d)", width, shift);
+    }
+    fprintf(out, ";\n    return 0");
+    for (int shift = 0; shift < width; shift++) {
+        if (masks[shift] == 0) continue;
+        if (shift == 0) {
+            fprintf(out, "\n        ^ (z & 0x%0*llX%s)", width / 4, (unsigned long long)masks[shift], suffix);
+        } else {
+            fprintf(out, "\n        ^ (rotl%d(z, %d) & 0x%0*llX%s)", width, shift,
+                    width / 4, (unsigned long long)masks[shift], suffix);
+        }
+    }
+    fprintf(out, ";\n}\n");
+}
+
+/**
+ * Emit chilow_jit_decrypt_32 for one key: the whitening words and the round keys
+ * XORed into the tweak become immediates, the key path disappears. The batch entry
+ * point inlines the same body into a plain loop that the compiler can vectorize.
+ */
+static void jit_emit_kernel_32(FILE* out, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t round_keys[NUM_ROUNDS];
+    
+    expand_round_keys(key, ROUND_CONSTANTS, NUM_ROUNDS, round_keys);
+    
+    fprintf(out, "/* Generated by chilow_jit_init(): ChiLow-32 decryption for one fixed key */\n");
+    fputs(JIT_PRELUDE, out);
+    jit_emit_chichi(out, "chichi_32", 32, 16);
+    jit_emit_chichi(out, "chichi_64", 64, 32);
+    jit_emit_linear(out, "linear_state_32", &STATE_PARAMS, 32);
+    jit_emit_linear(out, "linear_prf_32", &PRF_PARAMS, 32);
+    jit_emit_linear(out, "linear_tweak_64", &TWEAK_PARAMS, 64);
+    
+    fprintf(out, "\nstatic inline uint64_t decrypt_32(uint32_t ciphertext, uint64_t tweak) {\n");
+    fprintf(out, "    uint32_t p = ciphertext ^ 0x%08llXU;\n", (unsigned long long)(key_hi & BITMASK_32));
+    fprintf(out, "    uint32_t t = ciphertext ^ 0x%08llXU;\n", (unsigned long long)(key_hi >> 32));
+    fprintf(out, "    tweak ^= 0x%016llXULL;\n", (unsigned long long)key_lo);
+    for (int round = 0; round < NUM_ROUNDS - 1; round++) {
+        fprintf(out, "\n    p = linear_state_32(chichi_32(p));\n");
+        fprintf(out, "    t = linear_prf_32(chichi_32(t));\n");
+        fprintf(out, "    tweak = linear_tweak_64(chichi_64(tweak));\n");
+        fprintf(out, "    p ^= (uint32_t)tweak;\n");
+        fprintf(out, "    t ^= (uint32_t)(tweak >> 32);\n");
+        fprintf(out, "    tweak ^= 0x%016llXULL;\n", (unsigned long long)round_keys[round]);
+    }
+    fprintf(out, "\n    p = chichi_32(p);\n");
+    fprintf(out, "    t = chichi_32(t);\n");
+    fprintf(out, "    tweak = linear_tweak_64(tweak);\n");
+    fprintf(out, "    p ^= (uint32_t)tweak;\n");
+    fprintf(out, "    t ^= (uint32_t)(tweak >> 32);\n");
+    fprintf(out, "    return ((uint64_t)t << 32) | p;\n");
+    fprintf(out, "}\n");
+    
+    fprintf(out, "\nuint64_t chilow_jit_decrypt_32(uint32_t ciphertext, uint64_t tweak) {\n");
+    fprintf(out, "    return decrypt_32(ciphertext, tweak);\n");
+    fprintf(out, "}\n");
+    fprintf(out, "\nvoid chilow_jit_decrypt_32_batch(const uint32_t* restrict ciphertexts,\n");
+    fprintf(out, "                                 const uint64_t* restrict tweaks,\n");
+    fprintf(out, "                                 uint64_t* restrict results, unsigned long num_blocks) {\n");
+    fprintf(out, "    for (unsigned long i = 0; i < num_blocks; i++) {\n");
+    fprintf(out, "        results[i] = decrypt_32(ciphertexts[i], tweaks[i]);\n");
+    fprintf(out, "    }\n");
+    fprintf(out, "}\n");
+}
+
+/**
+ * Cache file name component: FNV-1a over the key and the generator version, so the
+ * key itself never appears in a file name
+ */
+static uint64_t jit_key_hash(uint64_t key_hi, uint64_t key_lo) {
+    uint64_t words[3] = {key_hi, key_lo, CHILOW_JIT_VERSION};
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    
+    for (int w = 0; w < 3; w++) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash ^= (words[w] >> (8 * byte)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * Create the cache directory if needed and refuse one that other users could access:
+ * anything in it is loaded into this process, and the kernels embed the key
+ */
+static int jit_prepare_cache_dir(const char* dir) {
+    struct stat info;
+    
+    if (mkdir(dir, 0700) != 0 && errno != EEXIST) return -1;
+    if (stat(dir, &info) != 0 || !S_ISDIR(info.st_mode)) return -1;
+    if (info.st_uid != geteuid() || (info.st_mode & (S_IRWXG | S_IRWXO)) != 0) return -1;
+    return 0;
+}
+
+/**
+ * Append the space-separated words of text (modified in place, no quoting) to argv;
+ * returns the new argument count, or -1 if it would exceed max_args
+ */
+static int jit_split_args(char* text, char** argv, int argc, int max_args) {
+    for (char* word = strtok(text, " \t"); word != NULL; word = strtok(NULL, " \t")) {
+        if (argc >= max_args) return -1;
+        argv[argc++] = word;
+    }
+    return argc;
+}
+
+/**
+ * Run the compiler without a shell and wait for it. The child runs with umask 077 so
+ * the library it writes is private to the caller.
+ */
+static int jit_run_compiler(char** argv) {
+    pid_t pid = fork();
+    int status;
+    
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        umask(077);
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+/**
+ * Write the kernel source and compile it into so_path. Both files are produced under
+ * process-unique temporary names and the library is renamed into place, so concurrent
+ * processes never load a partially written kernel. The source is created with mode 0600
+ * and the library under umask 077, since both hold the key.
+ */
+static int jit_compile_32(const char* so_path, uint64_t key_hi, uint64_t key_lo) {
+    char src_path[JIT_PATH_MAX + 32], tmp_path[JIT_PATH_MAX + 32];
+    char cc_words[JIT_PATH_MAX], flag_words[] = CHILOW_JIT_CFLAGS;
+    char* argv[JIT_MAX_ARGS + 8];
+    const char* cc = getenv("CHILOW_JIT_CC");
+    FILE* out;
+    int fd, argc, status;
+    
+    if (cc == NULL || cc[0] == '\0') cc = CHILOW_JIT_CC;
+    if (snprintf(cc_words, sizeof(cc_words), "%s", cc) >= (int)sizeof(cc_words)) return -1;
+    argc = jit_split_args(cc_words, argv, 0, JIT_MAX_ARGS);
+    if (argc > 0) argc = jit_split_args(flag_words, argv, argc, JIT_MAX_ARGS);
+    if (argc <= 0) return -1;
+    
+    snprintf(src_path, sizeof(src_path), "%s.%ld.c", so_path, (long)getpid());
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", so_path, (long)getpid());
+    argv[argc++] = "-fPIC";
+    argv[argc++] = "-shared";
+    argv[argc++] = "-o";
+    argv[argc++] = tmp_path;
+    argv[argc++] = src_path;
+    argv[argc] = NULL;
+    
+    /* Create the file 0600 first; fopen then reuses it (ISO C stdio has no mode argument) */
+    remove(src_path);
+    fd = open(src_path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 || close(fd) != 0) return -1;
+    out = fopen(src_path, "w");
+    if (out == NULL) {
+        remove(src_path);
+        return -1;
+    }
+    jit_emit_kernel_32(out, key_hi, key_lo);
+    if (fclose(out) != 0) {
+        remove(src_path);
+        return -1;
+    }
+    
+    status = jit_run_compiler(argv);
+    remove(src_path);
+    if (status != 0 || rename(tmp_path, so_path) != 0) {
+        remove(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Load a compiled kernel and cross-check it against chilow_decrypt_32bit on
+ * pseudo-random blocks; on any failure the library is closed again
+ */
+static int jit_load_32(chilow_jit_t* jit, const char* so_path, uint64_t key_hi, uint64_t key_lo) {
+    void* handle = dlopen(so_path, RTLD_NOW | RTLD_LOCAL);
+    void* symbol;
+    void* batch_symbol;
+    chilow_jit_fn_32 kernel;
+    chilow_jit_batch_fn_32 batch;
+    uint32_t ciphertexts[CHILOW_JIT_VERIFY_BLOCKS];
+    uint64_t tweaks[CHILOW_JIT_VERIFY_BLOCKS], results[CHILOW_JIT_VERIFY_BLOCKS];
+    uint64_t state = jit_key_hash(key_hi, key_lo);
+    
+    if (handle == NULL) return -1;
+    symbol = dlsym(handle, "chilow_jit_decrypt_32");
+    batch_symbol = dlsym(handle, "chilow_jit_decrypt_32_batch");
+    if (symbol == NULL || batch_symbol == NULL) {
+        dlclose(handle);
+        return -1;
+    }
+    /* ISO C has no object-to-function pointer conversion; POSIX guarantees this copy works */
+    memcpy(&kernel, &symbol, sizeof(kernel));
+    memcpy(&batch, &batch_symbol, sizeof(batch));
+    
+    for (int i = 0; i < CHILOW_JIT_VERIFY_BLOCKS; i++) {
+        /* splitmix64 */
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        ciphertexts[i] = (uint32_t)(z >> 16);
+        tweaks[i] = z * 0x9E3779B97F4A7C15ULL;
+    }
+    batch(ciphertexts, tweaks, results, CHILOW_JIT_VERIFY_BLOCKS);
+    for (int i = 0; i < CHILOW_JIT_VERIFY_BLOCKS; i++) {
+        uint64_t expected = chilow_decrypt_32bit(ciphertexts[i], tweaks[i], key_hi, key_lo);
+        if (kernel(ciphertexts[i], tweaks[i]) != expected || results[i] != expected) {
+            dlclose(handle);
+            return -1;
+        }
+    }
+    
+    jit->decrypt_32bit = kernel;
+    jit->decrypt_32bit_batch = batch;
+    jit->handle = handle;
+    return 0;
+}
+
+#endif /* CHILOW_JIT */
+
+/* ========================================================================== */
+/*                              PUBLIC INTERFACE                             */
+/* ========================================================================== */
+
+/**
+ * Initialize the ChiLow implementation
+ * Must be called before using any decryption functions (also selects the runtime kernel)
+ */
+void chilow_init(void) {
+    initialize_linear_matrices();
+    kernel_select();
+}
+
+/**
+ * Name of the kernel behind chilow_decrypt_32bit/40bit and the bitsliced API
+ * ("scalar", "bmi2", "avx2" or "avx512")
+ */
+const char* chilow_kernel_name(void) {
+    return kernel_active->name;
+}
+
+/**
+ * Switch to the named kernel; returns -1 (keeping the current one) if it is unknown
+ * or unsupported on this CPU. Not thread-safe: call before decrypting from other threads.
+ */
+int chilow_set_kernel(const char* name) {
+    const kernel_table_t* kernel = kernel_find(name);
+    if (kernel == NULL) return -1;
+    kernel_active = kernel;
+    return 0;
+}
+
+/**
+ * Cross-check the compile-time and (when available) GFNI linear layers
+ * against the reference popcount matrices, and the inverse state layers against the
+ * forward ones. All are linear, so agreeing on every unit vector proves them identical.
+ * Returns the number of mismatching layers (0 on success).
+ */
+int chilow_check_linear_layers(void) {
+    int mismatches[5] = {0, 0, 0, 0, 0};
+    
+    for (int bit = 0; bit < 128; bit++) {
+        uint128_t unit = {bit < 64 ? 1ULL << bit : 0, bit >= 64 ? 1ULL << (bit - 64) : 0};
+        uint128_t expected = apply_linear_128(unit, linear_matrix_128);
+        uint128_t actual = linear_const_128(unit, &KEY_PARAMS);
+        
+        if (expected.lo != actual.lo || expected.hi != actual.hi) mismatches[4] = 1;
+        if (bit < 64 && linear_const_64(unit.lo, &TWEAK_PARAMS, 64) != apply_linear_64(unit.lo, linear_matrix_64)) {
+            mismatches[3] = 1;
+        }
+        if (bit < 40 && linear_const_64(unit.lo, &STATE40_PARAMS, 40) != apply_linear_40(unit.lo, linear_matrix_40)) {
+            mismatches[2] = 1;
+        }
+        if (bit < 40 && apply_linear_40(apply_linear_40(unit.lo, linear_matrix_40), linear_matrix_40_inv) != unit.lo) {
+            mismatches[2] = 1;
+        }
+        if (bit < 40 && linear_const_inv_64(unit.lo, &STATE40_INV_PARAMS, 40) != apply_linear_40(unit.lo, linear_matrix_40_inv)) {
+            mismatches[2] = 1;
+        }
+#ifdef CHILOW_HAVE_X86_SIMD
+        if (linear_use_gfni) {
+            uint128_t gfni = apply_linear_gfni(unit, &linear_gfni_128);
+            if (expected.lo != gfni.lo || expected.hi != gfni.hi) mismatches[4] = 1;
+            if (bit < 64 && apply_linear_gfni_64(unit.lo, &linear_gfni_64) != apply_linear_64(unit.lo, linear_matrix_64)) {
+                mismatches[3] = 1;
+            }
+            if (bit < 40 && apply_linear_gfni_64(unit.lo, &linear_gfni_40) != apply_linear_40(unit.lo, linear_matrix_40)) {
+                mismatches[2] = 1;
+            }
+            if (bit < 32 && apply_linear_gfni_64(unit.lo, &linear_gfni_32_prf) != apply_linear_32((uint32_t)unit.lo, linear_matrix_32_prf)) {
+                mismatches[1] = 1;
+            }
+            if (bit < 32 && apply_linear_gfni_64(unit.lo, &linear_gfni_32_state) != apply_linear_32((uint32_t)unit.lo, linear_matrix_32_state)) {
+                mismatches[0] = 1;
+            }
+        }
+#endif
+        if (bit < 32) {
+            uint32_t unit32 = (uint32_t)unit.lo;
+            if ((uint32_t)linear_const_64(unit32, &PRF_PARAMS, 32) != apply_linear_32(unit32, linear_matrix_32_prf)) {
+                mismatches[1] = 1;
+            }
+            if ((uint32_t)linear_const_64(unit32, &STATE_PARAMS, 32) != apply_linear_32(unit32, linear_matrix_32_state)) {
+                mismatches[0] = 1;
+            }
+            if (apply_linear_32(apply_linear_32(unit32, linear_matrix_32_state), linear_matrix_32_state_inv) != unit32) {
+                mismatches[0] = 1;
+            }
+            if ((uint32_t)linear_const_inv_64(unit32, &STATE_INV_PARAMS, 32) != apply_linear_32(unit32, linear_matrix_32_state_inv)) {
+                mismatches[0] = 1;
+            }
+        }
+    }
+    
+    return mismatches[0] + mismatches[1] + mismatches[2] + mismatches[3] + mismatches[4];
+}
+
+/**
+ * Expand a key into a context (no chilow_init() required)
+ */
+void chilow_ctx_init(chilow_ctx_t* ctx, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    
+    ctx->key_hi = key_hi;
+    ctx->key_lo = key_lo;
+    expand_round_keys(key, ROUND_CONSTANTS, NUM_ROUNDS, ctx->round_keys_32);
+    expand_round_keys(key, ROUND_CONSTANTS_40, NUM_ROUNDS, ctx->round_keys_40);
+}
+
+/**
+ * Context-based decryption - 32-bit variant
+ */
+uint64_t chilow_ctx_decrypt_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak) {
+    return ctx_engine_32_full_7(ctx, ciphertext, tweak);
+}
+
+/**
+ * Context-based decryption - 40-bit variant
+ */
+uint64_t chilow_ctx_decrypt_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak) {
+    return ctx_engine_40_full_7(ctx, ciphertext, tweak);
+}
+
+/**
+ * Initialize an empty tweak schedule cache bound to an expanded-key context
+ */
+void chilow_tweak_cache_init(chilow_tweak_cache_t* cache, const chilow_ctx_t* ctx) {
+    memset(cache, 0, sizeof(*cache));
+    cache->ctx = ctx;
+}
+
+/**
+ * Cached decryption - 32-bit variant (same result as chilow_ctx_decrypt_32bit)
+ */
+uint64_t chilow_cached_decrypt_32bit(chilow_tweak_cache_t* cache, uint32_t ciphertext, uint64_t tweak) {
+    const uint64_t* masks = tweak_cache_lookup(cache, tweak, TWEAK_CACHE_VARIANT_32);
+    return masked_decrypt_32(cache->ctx->key_hi, ciphertext, masks);
+}
+
+/**
+ * Cached decryption - 40-bit variant (same result as chilow_ctx_decrypt_40bit)
+ */
+uint64_t chilow_cached_decrypt_40bit(chilow_tweak_cache_t* cache, uint64_t ciphertext, uint64_t tweak) {
+    const uint64_t* masks = tweak_cache_lookup(cache, tweak, TWEAK_CACHE_VARIANT_40);
+    return masked_decrypt_40(cache->ctx->key_hi, ciphertext, masks);
+}
+
+/**
+ * Context-based decryption with reduced rounds (r-1 full rounds + final round);
+ * num_rounds is clamped to [0, 8]
+ */
+uint64_t chilow_ctx_reduced_round_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_32_REDUCED[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+uint64_t chilow_ctx_reduced_round_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_40_REDUCED[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+/**
+ * Context-based decryption with reduced rounds, without final linear layer
+ */
+uint64_t chilow_ctx_half_reduced_round_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_32_HALF_REDUCED[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+uint64_t chilow_ctx_half_reduced_round_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_40_HALF_REDUCED[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+/**
+ * Context-based decryption with exactly num_rounds complete rounds (for integral cryptanalysis)
+ */
+uint64_t chilow_ctx_complete_rounds_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_32_COMPLETE[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+uint64_t chilow_ctx_complete_rounds_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds) {
+    return CTX_ENGINE_40_COMPLETE[clamp_rounds(num_rounds)](ctx, ciphertext, tweak);
+}
+
+/**
+ * Context-based round sweep (same result as chilow_round_sweep_32bit / _40bit)
+ */
+void chilow_ctx_round_sweep_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak,
+                                  chilow_round_sweep_t* sweep) {
+    uint128_t key = {ctx->key_lo, ctx->key_hi};
+    sweep_decrypt_32(ciphertext, tweak, key, ctx->round_keys_32, sweep);
+}
+
+void chilow_ctx_round_sweep_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak,
+                                  chilow_round_sweep_t* sweep) {
+    uint128_t key = {ctx->key_lo, ctx->key_hi};
+    sweep_decrypt_40(ciphertext, tweak, key, ctx->round_keys_40, sweep);
+}
+
+#ifdef CHILOW_JIT
+/**
+ * Build (or load from cache_dir) a decryption kernel specialized to one key.
+ * cache_dir may be NULL: $CHILOW_JIT_CACHE, then $HOME/.cache/chilow-jit is used.
+ * The cached kernels hold key material (the whitening words are the raw key), so the
+ * directory must be owned by the caller with no group or other permissions.
+ * A cached kernel that fails verification is rebuilt once. Returns 0 on success;
+ * on failure the kernel pointers are NULL and the caller should use a context instead.
+ */
+int chilow_jit_init(chilow_jit_t* jit, uint64_t key_hi, uint64_t key_lo, const char* cache_dir) {
+    char default_dir[JIT_PATH_MAX], so_path[JIT_PATH_MAX];
+    
+    jit->decrypt_32bit = NULL;
+    jit->decrypt_32bit_batch = NULL;
+    jit->handle = NULL;
+    jit->from_cache = 0;
+    
+    if (cache_dir == NULL) cache_dir = getenv("CHILOW_JIT_CACHE");
+    if (cache_dir == NULL || cache_dir[0] == '\0') {
+        const char* home = getenv("HOME");
+        if (home == NULL) return -1;
+        if (snprintf(default_dir, sizeof(default_dir), "%s/.cache", home) >= JIT_PATH_MAX - 16) return -1;
+        mkdir(default_dir, 0700);
+        strcat(default_dir, "/chilow-jit");
+        cache_dir = default_dir;
+    }
+    if (jit_prepare_cache_dir(cache_dir) != 0) return -1;
+    if (snprintf(so_path, sizeof(so_path), "%s/chilow32_%016llx.so", cache_dir,
+                 (unsigned long long)jit_key_hash(key_hi, key_lo)) >= JIT_PATH_MAX) return -1;
+    
+    if (access(so_path, F_OK) == 0) {
+        if (jit_load_32(jit, so_path, key_hi, key_lo) == 0) {
+            jit->from_cache = 1;
+            return 0;
+        }
+        remove(so_path);
+    }
+    if (jit_compile_32(so_path, key_hi, key_lo) != 0) return -1;
+    if (jit_load_32(jit, so_path, key_hi, key_lo) != 0) {
+        remove(so_path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Unload a kernel built by chilow_jit_init (the cached file is kept)
+ */
+void chilow_jit_free(chilow_jit_t* jit) {
+    if (jit->handle != NULL) dlclose(jit->handle);
+    jit->decrypt_32bit = NULL;
+    jit->decrypt_32bit_batch = NULL;
+    jit->handle = NULL;
+}
+#endif
+
+/**
+ * ChiLow decryption - 32-bit variant
+ */
+uint64_t chilow_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    return kernel_active->decrypt_32(ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 40-bit variant  
+ */
+uint64_t chilow_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    return kernel_active->decrypt_40(ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow encryption - 32-bit variant: returns (tag << 32) | ciphertext
+ */
+uint64_t chilow_encrypt_32bit(uint32_t plaintext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    return chilow_encrypt_32(plaintext, tweak, key);
+}
+
+/**
+ * ChiLow encryption - 40-bit variant
+ */
+uint64_t chilow_encrypt_40bit(uint64_t plaintext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    return chilow_encrypt_40(plaintext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 32-bit variant, recording the state after every layer in *trace
+ */
+uint64_t chilow_trace_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo,
+                                    chilow_trace_t* trace) {
+    uint128_t key = {key_lo, key_hi};
+    return engine_decrypt_32(ciphertext, tweak, key, NULL, NUM_ROUNDS - 1, FINAL_ROUND_FULL, trace, NULL);
+}
+
+/**
+ * ChiLow decryption - 40-bit variant, recording the state after every layer in *trace
+ */
+uint64_t chilow_trace_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo,
+                                    chilow_trace_t* trace) {
+    uint128_t key = {key_lo, key_hi};
+    return engine_decrypt_40(ciphertext, tweak, key, NULL, NUM_ROUNDS - 1, FINAL_ROUND_FULL, trace, NULL);
+}
+
+/**
+ * Cross-check the key-path implementations (two-word, unsigned __int128, SSE2 and the
+ * compiled-in default) on every single-bit key and on pseudo-random keys
+ * Returns the number of mismatching key updates (0 when all paths agree)
+ */
+int chilow_check_key_paths(void) {
+    uint64_t state = 0x6B65792D70617468ULL;
+    int mismatches = 0;
+    
+    for (int i = 0; i < 128 + CHILOW_KEY_PATH_CHECKS; i++) {
+        uint128_t key = {0, 0};
+        uint64_t constant = 0;
+        if (i < 128) {
+            if (i < 64) key.lo = 1ULL << i; else key.hi = 1ULL << (i - 64);
+        } else {
+            /* splitmix64 */
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            key.lo = z;
+            key.hi = z * 0x9E3779B97F4A7C15ULL ^ (z >> 17);
+            constant = ROUND_CONSTANTS[i % NUM_ROUNDS];
+        }
+        
+        uint128_t expected = key_round_words(key, constant);
+        uint128_t dispatched = key;
+        dispatched.hi ^= constant;
+        dispatched = linear_layer_key_128(chichi_transform_128(dispatched));
+        if (dispatched.lo != expected.lo || dispatched.hi != expected.hi) mismatches++;
+#ifdef CHILOW_HAVE_INT128
+        uint128_t wide = key_round_int128(key, constant);
+        if (wide.lo != expected.lo || wide.hi != expected.hi) mismatches++;
+#endif
+#ifdef CHILOW_HAVE_X86_SIMD
+        uint128_t sse = key_round_sse(key, constant);
+        if (sse.lo != expected.lo || sse.hi != expected.hi) mismatches++;
+#endif
+    }
+    return mismatches;
+}
+
+/**
+ * ChiLow decryption - 32-bit variant with reduced rounds
+ */
+uint64_t chilow_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_32_REDUCED[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 40-bit variant with reduced rounds
+ */
+uint64_t chilow_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_40_REDUCED[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 32-bit variant with reduced rounds, without final linear layer
+ */
+uint64_t chilow_half_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_32_HALF_REDUCED[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 32-bit variant with exactly num_rounds complete rounds (for integral cryptanalysis)
+ */
+uint64_t chilow_complete_rounds_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_32_COMPLETE[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 40-bit variant with exactly num_rounds complete rounds (for integral cryptanalysis)
+ */
+uint64_t chilow_complete_rounds_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_40_COMPLETE[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * ChiLow decryption - 40-bit variant with reduced rounds, without final linear layer
+ */
+uint64_t chilow_half_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds) {
+    uint128_t key = {key_lo, key_hi};
+    return ENGINE_40_HALF_REDUCED[clamp_rounds(num_rounds)](ciphertext, tweak, key);
+}
+
+/**
+ * Round sweep - 32-bit variant: fills sweep->reduced[r], half_reduced[r] and complete[r]
+ * with chilow_reduced_round_32bit, chilow_half_reduced_round_32bit and
+ * chilow_complete_rounds_32bit for every r in [0, 8], in a single pass
+ */
+void chilow_round_sweep_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo,
+                              chilow_round_sweep_t* sweep) {
+    uint128_t key = {key_lo, key_hi};
+    sweep_decrypt_32(ciphertext, tweak, key, NULL, sweep);
+}
+
+/**
+ * Round sweep - 40-bit variant
+ */
+void chilow_round_sweep_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo,
+                              chilow_round_sweep_t* sweep) {
+    uint128_t key = {key_lo, key_hi};
+    sweep_decrypt_40(ciphertext, tweak, key, NULL, sweep);
+}
+
+/**
+ * Bitsliced batch decryption - 32-bit variant
+ * Decrypts num_blocks independent blocks under one key; results[i] matches
+ * chilow_decrypt_32bit(ciphertexts[i], tweaks[i], key_hi, key_lo). Batches are
+ * processed 512, 256 or 64 blocks at a time; any remainder is zero-padded.
+ */
+void chilow_decrypt_32bit_bitsliced(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                    uint64_t key_hi, uint64_t key_lo,
+                                    uint64_t* results, size_t num_blocks) {
+    bs_decrypt_batch(kernel_active->bs_chunk, 0, ciphertexts, NULL, tweaks, key_hi, key_lo, NUM_ROUNDS - 1, FINAL_ROUND_FULL,
+                     results, num_blocks);
+}
+
+/**
+ * Bitsliced batch decryption - 40-bit variant
+ */
+void chilow_decrypt_40bit_bitsliced(const uint64_t* ciphertexts, const uint64_t* tweaks,
+                                    uint64_t key_hi, uint64_t key_lo,
+                                    uint64_t* results, size_t num_blocks) {
+    bs_decrypt_batch(kernel_active->bs_chunk, 1, NULL, ciphertexts, tweaks, key_hi, key_lo, NUM_ROUNDS - 1, FINAL_ROUND_FULL,
+                     results, num_blocks);
+}
+
+/**
+ * Threaded bulk decryption - 32-bit variant
+ * results[i] matches chilow_ctx_decrypt_32bit(ctx, ciphertexts[i], tweaks[i]). The array
+ * is split over `threads` threads (<= 0: all online cores) from a persistent pool; calls
+ * from different threads are serialized.
+ */
+void chilow_decrypt_32bit_bulk(const chilow_ctx_t* ctx, const uint32_t* ciphertexts,
+                               const uint64_t* tweaks, uint64_t* results, size_t num_blocks,
+                               int threads) {
+    bulk_job_t job = {0, ciphertexts, NULL, tweaks, ctx, results, num_blocks};
+    bulk_decrypt(&job, threads);
+}
+
+/**
+ * Threaded bulk decryption - 40-bit variant
+ */
+void chilow_decrypt_40bit_bulk(const chilow_ctx_t* ctx, const uint64_t* ciphertexts,
+                               const uint64_t* tweaks, uint64_t* results, size_t num_blocks,
+                               int threads) {
+    bulk_job_t job = {1, NULL, ciphertexts, tweaks, ctx, results, num_blocks};
+    bulk_decrypt(&job, threads);
+}
+
+/**
+ * Join the bulk decryption worker threads (they are recreated on the next bulk call)
+ */
+void chilow_bulk_shutdown(void) {
+    bulk_shutdown();
+}
+
+/**
+ * Lane-parallel batch decryption - 32-bit variant
+ * Each block has its own tweak and key (keys_hi[i], keys_lo[i]); results[i] matches
+ * chilow_decrypt_32bit. Runs 8 blocks per step with AVX-512, 4 with AVX2 and falls
+ * back to the scalar path for the remainder or when neither ISA is available. Both use
+ * compile-time linear layers, so no chilow_init() is needed.
+ */
+void chilow_decrypt_32bit_lanes(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                const uint64_t* keys_hi, const uint64_t* keys_lo,
+                                uint64_t* results, size_t num_blocks) {
+    size_t i = 0;
+    
+#ifdef CHILOW_HAVE_X86_SIMD
+    size_t step = (size_t)lanes_per_step();
+    for (; step > 1 && i + step <= num_blocks; i += step) {
+        if (step == 8) {
+            lanes_decrypt_32_avx512(ciphertexts + i, tweaks + i, keys_hi + i, keys_lo + i, results + i);
+        } else {
+            lanes_decrypt_32_avx2(ciphertexts + i, tweaks + i, keys_hi + i, keys_lo + i, results + i);
+        }
+    }
+#endif
+    for (; i < num_blocks; i++) {
+        uint128_t key = {keys_lo[i], keys_hi[i]};
+        results[i] = engine_32_full_7(ciphertexts[i], tweaks[i], key);
+    }
+}
+
+/**
+ * Lane-parallel batch decryption - 40-bit variant
+ */
+void chilow_decrypt_40bit_lanes(const uint64_t* ciphertexts, const uint64_t* tweaks,
+                                const uint64_t* keys_hi, const uint64_t* keys_lo,
+                                uint64_t* results, size_t num_blocks) {
+    size_t i = 0;
+    
+#ifdef CHILOW_HAVE_X86_SIMD
+    size_t step = (size_t)lanes_per_step();
+    for (; step > 1 && i + step <= num_blocks; i += step) {
+        if (step == 8) {
+            lanes_decrypt_40_avx512(ciphertexts + i, tweaks + i, keys_hi + i, keys_lo + i, results + i);
+        } else {
+            lanes_decrypt_40_avx2(ciphertexts + i, tweaks + i, keys_hi + i, keys_lo + i, results + i);
+        }
+    }
+#endif
+    for (; i < num_blocks; i++) {
+        uint128_t key = {keys_lo[i], keys_hi[i]};
+        results[i] = engine_40_full_7(ciphertexts[i], tweaks[i], key);
+    }
+}
+
+/**
+ * Tag verification - 32-bit variant
+ * Returns 1 if the tag of chilow_decrypt_32bit(ciphertext, tweak, key_hi, key_lo) equals
+ * `tag` (compared without data-dependent branches) and then stores the plaintext if
+ * `plaintext` is not NULL; returns 0 and leaves `plaintext` untouched otherwise.
+ */
+int chilow_verify_32bit(uint32_t ciphertext, uint64_t tweak, uint32_t tag, uint64_t key_hi,
+                        uint64_t key_lo, uint32_t* plaintext) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t result = kernel_active->decrypt_32(ciphertext, tweak, key);
+    uint32_t diff = (uint32_t)(result >> 32) ^ tag;
+    int valid = (int)(((uint64_t)diff - 1) >> 63);
+    
+    if (valid && plaintext != NULL) *plaintext = (uint32_t)result;
+    return valid;
+}
+
+/**
+ * Batch tag verification - 32-bit variant
+ * Bit i % 64 of bitmap[i / 64] is set when block i carries tags[i] (unused high bits of the
+ * last word are cleared). If `plaintexts` is not NULL, plaintexts[i] is written for
+ * verified blocks only. Returns the number of verified blocks.
+ */
+size_t chilow_verify_32bit_batch(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                 const uint32_t* tags, uint64_t key_hi, uint64_t key_lo,
+                                 uint64_t* bitmap, uint32_t* plaintexts, size_t num_blocks) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t round_keys[NUM_ROUNDS];
+    size_t done = 0, verified = 0;
+    
+    expand_round_keys(key, ROUND_CONSTANTS, NUM_ROUNDS - 1, round_keys);
+    while (done < num_blocks) {
+        size_t remaining = num_blocks - done;
+        int limbs = (remaining >= 512) ? 8 : (remaining >= 256) ? 4 : 1;
+        size_t count = (remaining < (size_t)limbs * 64) ? remaining : (size_t)limbs * 64;
+        
+        kernel_active->bs_verify(limbs, ciphertexts + done, tweaks + done, tags + done, key_hi, key_lo,
+                                 round_keys, bitmap + done / 64, plaintexts ? plaintexts + done : NULL,
+                                 count);
+        done += count;
+    }
+    for (size_t word = 0; word < (num_blocks + 63) / 64; word++) {
+        verified += (size_t)popcount64(bitmap[word]);
+    }
+    return verified;
+}
+
+/**
+ * Tweak of the 32-bit word `index` of a buffer at `address`: the word's byte address
+ * (address + 4 * index) in the low CHILOW_MEMORY_DOMAIN_SHIFT bits, the caller's
+ * domain-separation bits above it. domain must not exceed CHILOW_MEMORY_DOMAIN_MAX;
+ * the encrypt/decrypt calls below reject larger ones.
+ */
+uint64_t chilow_memory_tweak(uint64_t address, size_t index, uint64_t domain) {
+    uint64_t word_address = address + 4 * (uint64_t)index;
+    uint64_t address_mask = (1ULL << CHILOW_MEMORY_DOMAIN_SHIFT) - 1;
+    return (word_address & address_mask) | (domain << CHILOW_MEMORY_DOMAIN_SHIFT);
+}
+
+/**
+ * Memory encryption: encrypt num_words words of a buffer at `address` (tweaks from
+ * chilow_memory_tweak) into ciphertexts and a parallel array of tags. The context's
+ * round keys are used directly, so no chilow_init() is needed. In place (ciphertexts ==
+ * plaintexts) is allowed. Returns -1 without writing anything if domain exceeds
+ * CHILOW_MEMORY_DOMAIN_MAX (its high bits would not reach the tweak), 0 otherwise.
+ */
+int chilow_memory_encrypt_32bit(const chilow_ctx_t* ctx, uint64_t address, uint64_t domain,
+                                const uint32_t* plaintexts, uint32_t* ciphertexts, uint32_t* tags,
+                                size_t num_words) {
+    uint64_t tweaks[MEMORY_TILE_WORDS];
+    
+    if (domain > CHILOW_MEMORY_DOMAIN_MAX) return -1;
+    for (size_t start = 0; start < num_words; start += MEMORY_TILE_WORDS) {
+        size_t count = num_words - start < MEMORY_TILE_WORDS ? num_words - start : MEMORY_TILE_WORDS;
+        memory_tweaks(address, start, domain, tweaks, count);
+        memory_encrypt_tile(ctx, plaintexts + start, tweaks, ciphertexts + start, tags + start, count);
+    }
+    return 0;
+}
+
+/**
+ * Memory decryption: inverse of chilow_memory_encrypt_32bit with tag verification.
+ * Words whose tag does not match are set to 0 in `plaintexts`. Returns the number of
+ * such words (0: the whole buffer authenticated). A domain above CHILOW_MEMORY_DOMAIN_MAX
+ * authenticates no word. In place is allowed.
+ */
+size_t chilow_memory_decrypt_32bit(const chilow_ctx_t* ctx, uint64_t address, uint64_t domain,
+                                   const uint32_t* ciphertexts, const uint32_t* tags,
+                                   uint32_t* plaintexts, size_t num_words) {
+    uint64_t tweaks[MEMORY_TILE_WORDS], bitmap[MEMORY_TILE_WORDS / 64];
+    size_t failures = 0;
+    
+    if (domain > CHILOW_MEMORY_DOMAIN_MAX) {
+        memset(plaintexts, 0, num_words * sizeof(uint32_t));
+        return num_words;
+    }
+    for (size_t start = 0; start < num_words; start += MEMORY_TILE_WORDS) {
+        size_t count = num_words - start < MEMORY_TILE_WORDS ? num_words - start : MEMORY_TILE_WORDS;
+        size_t done = 0;
+        
+        memory_tweaks(address, start, domain, tweaks, count);
+        while (done < count) {
+            size_t remaining = count - done;
+            int limbs = (remaining >= 512) ? 8 : (remaining >= 256) ? 4 : 1;
+            size_t chunk = (remaining < (size_t)limbs * 64) ? remaining : (size_t)limbs * 64;
+            
+            kernel_active->bs_verify(limbs, ciphertexts + start + done, tweaks + done, tags + start + done,
+                                     ctx->key_hi, ctx->key_lo, ctx->round_keys_32, bitmap + done / 64,
+                                     plaintexts + start + done, chunk);
+            done += chunk;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!((bitmap[i / 64] >> (i % 64)) & 1)) {
+                plaintexts[start + i] = 0;
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * Spec of the published ChiLow-(32+tau)
+ */
+void chilow_spec_init_32bit(chilow_spec_t* spec) {
+    memset(spec, 0, sizeof(*spec));
+    spec->state_width = 32;
+    spec->num_rounds = NUM_ROUNDS;
+    spec->tag = 1;
+    memcpy(spec->state_alpha, STATE_PARAMS.alpha, sizeof(spec->state_alpha));
+    memcpy(spec->state_beta, STATE_PARAMS.beta, sizeof(spec->state_beta));
+    memcpy(spec->prf_alpha, PRF_PARAMS.alpha, sizeof(spec->prf_alpha));
+    memcpy(spec->prf_beta, PRF_PARAMS.beta, sizeof(spec->prf_beta));
+    spec->round_constant_flags = 0;
+}
+
+/**
+ * Spec of the published ChiLow-40
+ */
+void chilow_spec_init_40bit(chilow_spec_t* spec) {
+    memset(spec, 0, sizeof(*spec));
+    spec->state_width = 40;
+    spec->num_rounds = NUM_ROUNDS;
+    spec->tag = 0;
+    memcpy(spec->state_alpha, STATE40_PARAMS.alpha, sizeof(spec->state_alpha));
+    memcpy(spec->state_beta, STATE40_PARAMS.beta, sizeof(spec->state_beta));
+    spec->round_constant_flags = 1ULL << 63;
+}
+
+/**
+ * Prepare an engine for a spec and key: round constants, round keys and linear layer
+ * index tables. Returns 0, or -1 (engine untouched) if the spec is invalid.
+ */
+int chilow_engine_init(chilow_engine_t* engine, const chilow_spec_t* spec, uint64_t key_hi, uint64_t key_lo) {
+    uint128_t key = {key_lo, key_hi};
+    uint64_t constants[CHILOW_SPEC_MAX_ROUNDS];
+    
+    if (!spec_valid(spec)) return -1;
+    memset(engine, 0, sizeof(*engine));
+    engine->spec = *spec;
+    engine->key_hi = key_hi;
+    engine->key_lo = key_lo;
+    for (int round = 0; round < spec->num_rounds; round++) {
+        constants[round] = spec_round_constant(spec->round_constant_flags, round);
+    }
+    expand_round_keys(key, constants, spec->num_rounds - 1, engine->round_keys);
+    spec_linear_index(engine->state_index, spec->state_alpha, spec->state_beta, spec->state_width);
+    if (spec->tag) {
+        spec_linear_index(engine->prf_index, spec->prf_alpha, spec->prf_beta, spec->state_width);
+    } else {
+        memcpy(engine->prf_index, engine->state_index, sizeof(engine->prf_index));
+    }
+    return 0;
+}
+
+/**
+ * Parameterized engine, one block (scalar reference): returns the n-bit plaintext and,
+ * if tag is not NULL, stores the n-bit tag (0 without a tag path)
+ */
+uint64_t chilow_engine_decrypt_block(const chilow_engine_t* engine, uint64_t ciphertext, uint64_t tweak,
+                                     uint64_t* tag) {
+    return engine_spec_block(engine, ciphertext, tweak, tag);
+}
+
+/**
+ * Parameterized engine, batch of any size on the active bitsliced kernel. tags may be
+ * NULL (it is left untouched without a tag path). Requires chilow_init().
+ */
+void chilow_engine_decrypt(const chilow_engine_t* engine, const uint64_t* ciphertexts, const uint64_t* tweaks,
+                           uint64_t* plaintexts, uint64_t* tags, size_t num_blocks) {
+    size_t done = 0;
+    
+    if (!engine->spec.tag) tags = NULL;
+    while (done < num_blocks) {
+        size_t remaining = num_blocks - done;
+        int limbs = (remaining >= 512) ? 8 : (remaining >= 256) ? 4 : 1;
+        size_t count = (remaining < (size_t)limbs * 64) ? remaining : (size_t)limbs * 64;
+        
+        kernel_active->bs_spec(engine, limbs, ciphertexts + done, tweaks + done, plaintexts + done,
+                               tags ? tags + done : NULL, count);
+        done += count;
+    }
+}
+
+/**
+ * Cube enumeration: set up the cube over mask with fixed part base and start at element
+ * 0. Returns -1 (cube left untouched) if all 64 bits are active.
+ */
+int chilow_cube_init(chilow_cube_t* cube, uint64_t base, uint64_t mask) {
+    int k = 0;
+    
+    if (mask == ~0ULL) return -1;
+    /* positions[k] stays 0: the step past the last element (to index 2^k) flips bit 0
+       of a value that is never produced */
+    memset(cube->positions, 0, sizeof(cube->positions));
+    for (int bit = 0; bit < 64; bit++) {
+        if ((mask >> bit) & 1) cube->positions[k++] = (uint8_t)bit;
+    }
+    cube->mask = mask;
+    cube->base = base & ~mask;
+    cube->num_active = k;
+    cube->size = 1ULL << k;
+    cube->element = cube->base;
+    cube->index = 0;
+    return 0;
+}
+
+/**
+ * Cube enumeration: element index (0 <= index < size) without moving the enumerator
+ */
+uint64_t chilow_cube_element(const chilow_cube_t* cube, uint64_t index) {
+    return cube->base | cube_deposit(index ^ (index >> 1), cube->mask);
+}
+
+/**
+ * Cube enumeration: make element index (0 <= index <= size) the next one produced
+ */
+void chilow_cube_seek(chilow_cube_t* cube, uint64_t index) {
+    cube->element = chilow_cube_element(cube, index);
+    cube->index = index;
+}
+
+/**
+ * Cube enumeration: write the next element; returns 0 once all elements were produced
+ */
+int chilow_cube_next(chilow_cube_t* cube, uint64_t* element) {
+    if (cube->index >= cube->size) return 0;
+    *element = cube->element;
+    cube->element ^= 1ULL << cube->positions[__builtin_ctzll(++cube->index)];
+    return 1;
+}
+
+/**
+ * Cube enumeration: write up to count next elements; returns the number written
+ */
+size_t chilow_cube_fill(chilow_cube_t* cube, uint64_t* elements, size_t count) {
+    uint64_t left = cube->size - cube->index;
+    uint64_t element = cube->element, index = cube->index;
+    
+    if (count > left) count = (size_t)left;
+    for (size_t i = 0; i < count; i++) {
+        elements[i] = element;
+        element ^= 1ULL << cube->positions[__builtin_ctzll(++index)];
+    }
+    cube->index = index;
+    cube->element = element;
+    return count;
+}
+
+/**
+ * Cube sum: XOR of chilow_complete_rounds_32bit((uint32_t)chilow_cube_element(cube, i),
+ * tweak, key_hi, key_lo, num_rounds) over i = first .. first + count - 1 (clipped to the
+ * cube), evaluated 512 elements per pass on the bitsliced engine. sums, if not NULL,
+ * receives the cube sum of every round count 0 .. num_rounds from the same single pass
+ * over the range. Requires chilow_init().
+ */
+uint64_t chilow_cube_sum_32bit(const chilow_cube_t* cube, uint64_t first, uint64_t count, uint64_t tweak,
+                               uint64_t key_hi, uint64_t key_lo, int num_rounds, uint64_t* sums) {
+    return cube_sum(0, cube, first, count, tweak, key_hi, key_lo, num_rounds, sums);
+}
+
+/**
+ * Cube sum over chilow_complete_rounds_40bit (see chilow_cube_sum_32bit)
+ */
+uint64_t chilow_cube_sum_40bit(const chilow_cube_t* cube, uint64_t first, uint64_t count, uint64_t tweak,
+                               uint64_t key_hi, uint64_t key_lo, int num_rounds, uint64_t* sums) {
+    return cube_sum(1, cube, first, count, tweak, key_hi, key_lo, num_rounds, sums);
+}
+
+/**
+ * Integral schedule: key and tweak paths of the 32-bit variant, run once per cube
+ */
+void chilow_integral_init_32bit(chilow_integral_t* integral, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    integral_schedule(integral, 0, tweak, key_hi, key_lo);
+}
+
+void chilow_integral_init_40bit(chilow_integral_t* integral, uint64_t tweak, uint64_t key_hi, uint64_t key_lo) {
+    integral_schedule(integral, 1, tweak, key_hi, key_lo);
+}
+
+/**
+ * Integral schedule: chilow_complete_rounds_32bit for the schedule's tweak and key, state
+ * and tag paths only
+ */
+uint64_t chilow_integral_rounds_32bit(const chilow_integral_t* integral, uint32_t ciphertext, int num_rounds,
+                                      uint64_t* outputs) {
+    return masked_complete_rounds_32(integral->key_hi, ciphertext, integral->masks, clamp_rounds(num_rounds),
+                                     outputs);
+}
+
+/**
+ * Integral schedule: chilow_complete_rounds_40bit, state path only
+ */
+uint64_t chilow_integral_rounds_40bit(const chilow_integral_t* integral, uint64_t ciphertext, int num_rounds,
+                                      uint64_t* outputs) {
+    return masked_complete_rounds_40(integral->key_hi, ciphertext, integral->masks, clamp_rounds(num_rounds),
+                                     outputs);
+}
+
+/**
+ * Counter-mode PRF: start the keystream of (ctx, nonce) at byte 0
+ */
+void chilow_prf_init(chilow_prf_t* prf, const chilow_ctx_t* ctx, uint32_t nonce) {
+    prf->ctx = ctx;
+    prf->nonce = nonce;
+    prf->position = 0;
+}
+
+/**
+ * Counter-mode PRF: move to an arbitrary byte offset of the keystream
+ */
+void chilow_prf_seek(chilow_prf_t* prf, uint64_t position) {
+    prf->position = position;
+}
+
+/**
+ * Counter-mode PRF: write the next num_bytes keystream bytes and advance the position.
+ * Output does not depend on how the stream is split across calls. Requires chilow_init().
+ */
+void chilow_prf_generate(chilow_prf_t* prf, uint8_t* out, size_t num_bytes) {
+    uint64_t results[PRF_TILE_BLOCKS];
+    
+    while (num_bytes > 0) {
+        uint64_t block = prf->position / 4;
+        size_t skip = (size_t)(prf->position % 4);
+        size_t blocks = (skip + num_bytes + 3) / 4;
+        size_t count = blocks < PRF_TILE_BLOCKS ? blocks : PRF_TILE_BLOCKS;
+        size_t bytes = count * 4 - skip;
+        
+        if (bytes > num_bytes) bytes = num_bytes;
+        prf_tile(prf->ctx, prf->nonce, block, results, count);
+        for (size_t i = 0; i < bytes; i++) {
+            out[i] = (uint8_t)(results[(skip + i) / 4] >> (32 + 8 * ((skip + i) % 4)));
+        }
+        out += bytes;
+        num_bytes -= bytes;
+        prf->position += bytes;
+    }
+}
+
+/**
+ * Pointer signing: encrypt the low 40 bits of each pointer under contexts[i] and place
+ * the check field in its upper bits. Needs only the context (no chilow_init()); in place
+ * is allowed.
+ */
+void chilow_pac_sign_40bit(const chilow_ctx_t* ctx, const chilow_pac_t* pac, const uint64_t* pointers,
+                           const uint64_t* contexts, uint64_t* signed_pointers, size_t num_pointers) {
+    uint64_t high[PAC_TILE_POINTERS], addresses[PAC_TILE_POINTERS], tweaks[PAC_TILE_POINTERS];
+    uint64_t check_mask = pac->check_mask & ~BITMASK_40;
+    
+    for (size_t start = 0; start < num_pointers; start += PAC_TILE_POINTERS) {
+        size_t count = num_pointers - start < PAC_TILE_POINTERS ? num_pointers - start : PAC_TILE_POINTERS;
+        
+        for (size_t i = 0; i < count; i++) {
+            uint64_t pointer = pointers[start + i];
+            high[i] = (pointer & ~BITMASK_40 & ~check_mask) | (pac->check & check_mask);
+            addresses[i] = pointer & BITMASK_40;
+            tweaks[i] = contexts[start + i] ^ high[i];
+        }
+        pac_sign_tile(ctx, addresses, tweaks, addresses, count);
+        for (size_t i = 0; i < count; i++) {
+            signed_pointers[start + i] = high[i] | addresses[i];
+        }
+    }
+}
+
+/**
+ * Pointer authentication: inverse of chilow_pac_sign_40bit. A pointer passes when its
+ * check field equals pac->check and its decrypted low 40 bits are 0 under pac->zero_mask;
+ * it is then restored with the check field cleared. Failing pointers are set to 0.
+ * Returns the number of failures. Needs only the context; in place is allowed.
+ */
+size_t chilow_pac_auth_40bit(const chilow_ctx_t* ctx, const chilow_pac_t* pac, const uint64_t* signed_pointers,
+                             const uint64_t* contexts, uint64_t* pointers, size_t num_pointers) {
+    uint64_t high[PAC_TILE_POINTERS], addresses[PAC_TILE_POINTERS], tweaks[PAC_TILE_POINTERS];
+    uint64_t check_mask = pac->check_mask & ~BITMASK_40;
+    size_t failures = 0;
+    
+    for (size_t start = 0; start < num_pointers; start += PAC_TILE_POINTERS) {
+        size_t count = num_pointers - start < PAC_TILE_POINTERS ? num_pointers - start : PAC_TILE_POINTERS;
+        
+        for (size_t i = 0; i < count; i++) {
+            uint64_t signed_pointer = signed_pointers[start + i];
+            high[i] = signed_pointer & ~BITMASK_40;
+            addresses[i] = signed_pointer & BITMASK_40;
+            tweaks[i] = contexts[start + i] ^ high[i];
+        }
+        bs_decrypt_range(kernel_active->bs_chunk, 1, NULL, addresses, tweaks, ctx->key_hi, ctx->key_lo,
+                         ctx->round_keys_40, NUM_ROUNDS - 1, FINAL_ROUND_FULL, addresses, count);
+        for (size_t i = 0; i < count; i++) {
+            uint64_t valid = (uint64_t)((high[i] & check_mask) == (pac->check & check_mask)) &
+                             (uint64_t)((addresses[i] & pac->zero_mask) == 0);
+            pointers[start + i] = ((high[i] & ~check_mask) | addresses[i]) & ((uint64_t)0 - valid);
+            failures += (size_t)(1 - valid);
+        }
+    }
+    return failures;
+}
+
+/**
+ * Strided batch decryption - 32-bit variant
+ * Record i has a uint32_t ciphertext at ciphertexts + i * ciphertext_stride, a uint64_t
+ * tweak, key words and a uint64_t result slot at the matching strides (key_stride 0:
+ * one key for all records). results match chilow_decrypt_32bit; see chilow_strided_t.
+ */
+void chilow_decrypt_32bit_strided(const chilow_strided_t* batch, size_t num_blocks) {
+    strided_decrypt(0, batch, num_blocks);
+}
+
+/**
+ * Strided batch decryption - 40-bit variant (uint64_t ciphertext fields, low 40 bits used)
+ */
+void chilow_decrypt_40bit_strided(const chilow_strided_t* batch, size_t num_blocks) {
+    strided_decrypt(1, batch, num_blocks);
 }
 
 /* ========================================================================== */
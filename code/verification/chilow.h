@@ -0,0 +1,404 @@
+/*
+ * ChiLow Independent Implementation - Public Interface
+ * 
+ * Types and function declarations for programs linking against chilow.c
+ * 
+ * Author: Hosein Hadipour <hsn.hadipour@gmail.com>
+ * Date: September 2025
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHILOW_H
+#define CHILOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ========================================================================== */
+/*                              TYPES                                        */
+/* ========================================================================== */
+
+#define CHILOW_NUM_ROUNDS 8
+
+/* 128-bit integer structure */
+typedef struct {
+    uint64_t lo;  /* Lower 64 bits */
+    uint64_t hi;  /* Upper 64 bits */
+} uint128_t;
+
+/*
+ * Expanded-key context: everything that depends only on the key, computed once by
+ * chilow_ctx_init(). round_keys_32[r] / round_keys_40[r] are the key words XORed into
+ * the tweak after full round r (round constants already applied). The linear layers are
+ * compile-time constants, so a context is read-only after initialization and can be
+ * shared between threads without calling chilow_init().
+ */
+typedef struct {
+    uint64_t key_hi;
+    uint64_t key_lo;
+    uint64_t round_keys_32[CHILOW_NUM_ROUNDS];
+    uint64_t round_keys_40[CHILOW_NUM_ROUNDS];
+} chilow_ctx_t;
+
+/*
+ * Tweak schedule cache: for a fixed (key, tweak) the words XORed into the state and tag
+ * are constant, so they are cached per tweak in a fixed-size open-addressing table.
+ * A tweak hashes to a home slot and may live in any of the CHILOW_TWEAK_CACHE_PROBE
+ * slots that follow; on a miss the least recently used slot of that window is replaced.
+ * hits/misses count lookups since chilow_tweak_cache_init() and may be read directly.
+ * A cache is modified by every lookup, so use one cache per thread (the context itself
+ * can be shared). CHILOW_TWEAK_CACHE_SLOTS must be a power of two.
+ */
+#ifndef CHILOW_TWEAK_CACHE_SLOTS
+#define CHILOW_TWEAK_CACHE_SLOTS 256
+#endif
+#ifndef CHILOW_TWEAK_CACHE_PROBE
+#define CHILOW_TWEAK_CACHE_PROBE 8
+#endif
+
+typedef struct {
+    uint64_t tweak;
+    uint64_t last_use;                   /* 0 marks an empty slot */
+    int variant;
+    uint64_t masks[CHILOW_NUM_ROUNDS];   /* tweak word before each interaction layer */
+} chilow_tweak_entry_t;
+
+typedef struct {
+    const chilow_ctx_t* ctx;
+    uint64_t clock;
+    uint64_t hits;
+    uint64_t misses;
+    chilow_tweak_entry_t slots[CHILOW_TWEAK_CACHE_SLOTS];
+} chilow_tweak_cache_t;
+
+/*
+ * Round sweep: the outputs of every round count r in [0, CHILOW_NUM_ROUNDS] under the
+ * three reduced-round conventions, as returned by chilow_reduced_round_*,
+ * chilow_half_reduced_round_* and chilow_complete_rounds_* with num_rounds = r.
+ */
+typedef struct {
+    uint64_t reduced[CHILOW_NUM_ROUNDS + 1];
+    uint64_t half_reduced[CHILOW_NUM_ROUNDS + 1];
+    uint64_t complete[CHILOW_NUM_ROUNDS + 1];
+} chilow_round_sweep_t;
+
+/*
+ * Round-state capture: the cipher state after each layer of a full decryption, filled
+ * by chilow_trace_decrypt_32bit / _40bit. rounds[r] covers round r (the last entry is
+ * the final round, whose linear layer only acts on the tweak and which leaves the key
+ * unchanged). tag is 0 for the 40-bit variant.
+ */
+typedef struct {
+    uint64_t plaintext;
+    uint64_t tag;
+    uint64_t tweak;
+    uint64_t key_hi;
+    uint64_t key_lo;
+} chilow_state_t;
+
+typedef struct {
+    chilow_state_t nonlinear;     /* after the chichi layer */
+    chilow_state_t linear;        /* after the linear layer */
+    chilow_state_t interaction;   /* after the tweak/key interaction */
+} chilow_round_trace_t;
+
+typedef struct {
+    chilow_state_t whitening;
+    chilow_round_trace_t rounds[CHILOW_NUM_ROUNDS];
+} chilow_trace_t;
+
+/*
+ * Strided batch: pointers to the fields of the first record plus the byte distance
+ * between consecutive records, so fields can be read from (and results written to)
+ * arrays of caller structs without packing. Ciphertexts are uint32_t (32-bit variant) or
+ * uint64_t (40-bit), the other fields uint64_t; fields need no particular alignment.
+ * With key_stride 0 every record uses the key at keys_hi/keys_lo. The result field may
+ * overlap the ciphertext or tweak field of the same record.
+ */
+typedef struct {
+    const void* ciphertexts;
+    size_t ciphertext_stride;
+    const void* tweaks;
+    size_t tweak_stride;
+    const void* keys_hi;
+    const void* keys_lo;
+    size_t key_stride;
+    void* results;
+    size_t result_stride;
+} chilow_strided_t;
+
+/*
+ * Signed-pointer layout for chilow_pac_sign_40bit / chilow_pac_auth_40bit. The low 40
+ * bits of a pointer are encrypted under a per-pointer context (the tweak); bits 40..63
+ * keep the pointer's upper bits, except check_mask, which carries the caller's check
+ * field. Bits 40..63 are folded into the tweak, so a modified check field or upper bit
+ * garbles the address. Authentication strength comes from the check field and from
+ * zero_mask: bits of the low 40 that are 0 in every valid pointer (alignment, unused
+ * address bits). Each such bit halves the chance that a forged address is accepted.
+ */
+typedef struct {
+    uint64_t check_mask;    /* bits of the signed pointer holding the check field (above bit 39) */
+    uint64_t check;         /* check field value, positioned under check_mask */
+    uint64_t zero_mask;     /* bits of the low 40 that are 0 in every valid pointer */
+} chilow_pac_t;
+
+/*
+ * Counter-mode keystream over the tag half of ChiLow-(32+tau): block b is the 32-bit
+ * tag for ciphertext (uint32_t)b and tweak (nonce << 32) | (b >> 32), written as 4
+ * little-endian bytes. position is the byte offset of the next output byte.
+ */
+typedef struct {
+    const chilow_ctx_t* ctx;
+    uint32_t nonce;
+    uint64_t position;
+} chilow_prf_t;
+
+/*
+ * Parameterized ChiLow-n for design-space exploration. The state (and, with tag set, the
+ * PRF path of ChiLow-(n+tau)) is n bits wide, n even in 8..64, and chichi splits it at
+ * n/2. Linear layer output bit r is the XOR of input bits (alpha[k] * r + beta[k]) mod n.
+ * num_rounds counts the full rounds plus the simplified final round, as NUM_ROUNDS does.
+ * Round constant i follows round_constants.py: round_constant_flags + ((i + (2^i << 4))
+ * << 32) mod 2^64 (flags 0 for ChiLow-32, 1 << 63 for ChiLow-40). The 64-bit tweak path
+ * and the 128-bit key path are those of ChiLow; the state takes the low n tweak bits and
+ * the tag the high n. chilow_spec_init_32bit/40bit give the published variants.
+ */
+#define CHILOW_SPEC_MAX_ROUNDS 32
+
+typedef struct {
+    int state_width;
+    int num_rounds;
+    int tag;                        /* nonzero: also compute the n-bit tag */
+    int state_alpha[3], state_beta[3];
+    int prf_alpha[3], prf_beta[3];
+    uint64_t round_constant_flags;
+} chilow_spec_t;
+
+/* Engine for one spec and key (chilow_engine_init): round keys and the generated
+   linear layers as the input bit index of each term of each output bit */
+typedef struct {
+    chilow_spec_t spec;
+    uint64_t key_hi;
+    uint64_t key_lo;
+    uint64_t round_keys[CHILOW_SPEC_MAX_ROUNDS];
+    uint8_t state_index[3][64];
+    uint8_t prf_index[3][64];
+} chilow_engine_t;
+
+/*
+ * Cube enumerator for integral and cube analysis. The cube over mask with fixed part base
+ * has 2^k elements, k = popcount(mask) <= 63; element i is (base & ~mask) | deposit(g, mask)
+ * with g = i ^ (i >> 1) (binary reflected Gray code) and deposit placing the low k bits of
+ * g at the set positions of mask, as PDEP does. Consecutive elements differ in one active
+ * bit, so chilow_cube_next and chilow_cube_fill flip one bit per element; seeking and
+ * random access use PDEP when the active kernel has BMI2 and a bit loop otherwise.
+ */
+typedef struct {
+    uint64_t mask;
+    uint64_t base;              /* fixed part (active bits clear) */
+    uint64_t size;              /* 2^k elements */
+    uint64_t index;             /* index of the next element */
+    uint64_t element;           /* value of the next element */
+    int num_active;
+    uint8_t positions[64];      /* active bit positions, ascending */
+} chilow_cube_t;
+
+/*
+ * Integral schedule: with the tweak and key fixed across a cube, the tweak path injects
+ * the same word into the state before every interaction layer. chilow_integral_init_*
+ * runs the key and tweak paths once and records those words; evaluating an input then
+ * runs only the state (and tag) path, with the same result as chilow_complete_rounds_*.
+ */
+typedef struct {
+    uint64_t key_hi;
+    uint64_t masks[CHILOW_NUM_ROUNDS];  /* tweak word entering interaction layer r */
+} chilow_integral_t;
+
+#ifdef CHILOW_JIT
+/*
+ * Key-specialized JIT (build with -DCHILOW_JIT, POSIX only): chilow_jit_init() emits C
+ * source for one key with the whitening words and round keys as immediates, compiles
+ * it with $CHILOW_JIT_CC (default gcc) into a shared object cached by key hash, and
+ * loads it with dlopen. decrypt_32bit(c, tweak) equals chilow_decrypt_32bit(c, tweak,
+ * key_hi, key_lo), and decrypt_32bit_batch does the same for num_blocks blocks in a
+ * loop the compiler vectorizes; every kernel is cross-checked against
+ * chilow_decrypt_32bit before being returned. The cached objects contain the raw key
+ * (as the whitening words) and its schedule, so a cache directory with any group or
+ * other permission is refused.
+ */
+typedef uint64_t (*chilow_jit_fn_32)(uint32_t ciphertext, uint64_t tweak);
+typedef void (*chilow_jit_batch_fn_32)(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                       uint64_t* results, unsigned long num_blocks);
+
+typedef struct {
+    chilow_jit_fn_32 decrypt_32bit;
+    chilow_jit_batch_fn_32 decrypt_32bit_batch;
+    void* handle;
+    int from_cache;    /* 1 if the kernel was loaded without compiling */
+} chilow_jit_t;
+#endif
+
+/* ========================================================================== */
+/*                              FUNCTIONS                                    */
+/* ========================================================================== */
+
+/* Initialization and self checks */
+void chilow_init(void);
+int chilow_check_linear_layers(void);
+void chilow_test_vectors(void);
+
+/* Single-block decryption */
+uint64_t chilow_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+uint64_t chilow_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+uint64_t chilow_half_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+uint64_t chilow_half_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+uint64_t chilow_complete_rounds_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+uint64_t chilow_complete_rounds_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+void chilow_round_sweep_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, chilow_round_sweep_t* sweep);
+void chilow_round_sweep_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, chilow_round_sweep_t* sweep);
+
+/* Single-block encryption (inverse of chilow_decrypt_32bit / chilow_decrypt_40bit) */
+uint64_t chilow_encrypt_32bit(uint32_t plaintext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_encrypt_40bit(uint64_t plaintext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+
+/* Round-state capture (same result as chilow_decrypt_32bit / chilow_decrypt_40bit) */
+uint64_t chilow_trace_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, chilow_trace_t* trace);
+uint64_t chilow_trace_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, chilow_trace_t* trace);
+
+/* Key-path self-check (two-word, unsigned __int128 and SSE2 key schedules; 0 = all agree) */
+int chilow_check_key_paths(void);
+
+/* Runtime kernel dispatch (selected by chilow_init(), overridable with $CHILOW_KERNEL) */
+const char* chilow_kernel_name(void);
+int chilow_set_kernel(const char* name);
+
+/* Expanded-key context */
+void chilow_ctx_init(chilow_ctx_t* ctx, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_ctx_decrypt_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak);
+uint64_t chilow_ctx_decrypt_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak);
+uint64_t chilow_ctx_reduced_round_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds);
+uint64_t chilow_ctx_reduced_round_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds);
+uint64_t chilow_ctx_half_reduced_round_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds);
+uint64_t chilow_ctx_half_reduced_round_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds);
+uint64_t chilow_ctx_complete_rounds_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, int num_rounds);
+uint64_t chilow_ctx_complete_rounds_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, int num_rounds);
+void chilow_ctx_round_sweep_32bit(const chilow_ctx_t* ctx, uint32_t ciphertext, uint64_t tweak, chilow_round_sweep_t* sweep);
+void chilow_ctx_round_sweep_40bit(const chilow_ctx_t* ctx, uint64_t ciphertext, uint64_t tweak, chilow_round_sweep_t* sweep);
+
+/* Parameterized ChiLow-n engine (see chilow_spec_t); chilow_engine_init returns -1 for an invalid spec */
+void chilow_spec_init_32bit(chilow_spec_t* spec);
+void chilow_spec_init_40bit(chilow_spec_t* spec);
+int chilow_engine_init(chilow_engine_t* engine, const chilow_spec_t* spec, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_engine_decrypt_block(const chilow_engine_t* engine, uint64_t ciphertext, uint64_t tweak,
+                                     uint64_t* tag);
+void chilow_engine_decrypt(const chilow_engine_t* engine, const uint64_t* ciphertexts, const uint64_t* tweaks,
+                           uint64_t* plaintexts, uint64_t* tags, size_t num_blocks);
+
+/* Cube enumeration in Gray-code order and bitsliced cube sums (see chilow_cube_t);
+   chilow_cube_init returns -1 for a full 64-bit mask. sums, if not NULL, receives the
+   cube sum of every round count 0..num_rounds from the same pass */
+int chilow_cube_init(chilow_cube_t* cube, uint64_t base, uint64_t mask);
+void chilow_cube_seek(chilow_cube_t* cube, uint64_t index);
+uint64_t chilow_cube_element(const chilow_cube_t* cube, uint64_t index);
+int chilow_cube_next(chilow_cube_t* cube, uint64_t* element);
+size_t chilow_cube_fill(chilow_cube_t* cube, uint64_t* elements, size_t count);
+uint64_t chilow_cube_sum_32bit(const chilow_cube_t* cube, uint64_t first, uint64_t count, uint64_t tweak,
+                               uint64_t key_hi, uint64_t key_lo, int num_rounds, uint64_t* sums);
+uint64_t chilow_cube_sum_40bit(const chilow_cube_t* cube, uint64_t first, uint64_t count, uint64_t tweak,
+                               uint64_t key_hi, uint64_t key_lo, int num_rounds, uint64_t* sums);
+
+/* Complete rounds under a hoisted tweak/key schedule (see chilow_integral_t); outputs, if not
+   NULL, receives the output after every round count 0..num_rounds */
+void chilow_integral_init_32bit(chilow_integral_t* integral, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+void chilow_integral_init_40bit(chilow_integral_t* integral, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
+uint64_t chilow_integral_rounds_32bit(const chilow_integral_t* integral, uint32_t ciphertext, int num_rounds,
+                                      uint64_t* outputs);
+uint64_t chilow_integral_rounds_40bit(const chilow_integral_t* integral, uint64_t ciphertext, int num_rounds,
+                                      uint64_t* outputs);
+
+#ifdef CHILOW_JIT
+/* Key-specialized JIT kernels */
+int chilow_jit_init(chilow_jit_t* jit, uint64_t key_hi, uint64_t key_lo, const char* cache_dir);
+void chilow_jit_free(chilow_jit_t* jit);
+#endif
+
+/* Tweak schedule cache */
+void chilow_tweak_cache_init(chilow_tweak_cache_t* cache, const chilow_ctx_t* ctx);
+uint64_t chilow_cached_decrypt_32bit(chilow_tweak_cache_t* cache, uint32_t ciphertext, uint64_t tweak);
+uint64_t chilow_cached_decrypt_40bit(chilow_tweak_cache_t* cache, uint64_t ciphertext, uint64_t tweak);
+
+/* Batch decryption under one key (bitsliced) */
+void chilow_decrypt_32bit_bitsliced(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                    uint64_t key_hi, uint64_t key_lo,
+                                    uint64_t* results, size_t num_blocks);
+void chilow_decrypt_40bit_bitsliced(const uint64_t* ciphertexts, const uint64_t* tweaks,
+                                    uint64_t key_hi, uint64_t key_lo,
+                                    uint64_t* results, size_t num_blocks);
+
+/* Tag verification (bitmap bit i % 64 of word i / 64 = block i verified) */
+int chilow_verify_32bit(uint32_t ciphertext, uint64_t tweak, uint32_t tag, uint64_t key_hi,
+                        uint64_t key_lo, uint32_t* plaintext);
+size_t chilow_verify_32bit_batch(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                 const uint32_t* tags, uint64_t key_hi, uint64_t key_lo,
+                                 uint64_t* bitmap, uint32_t* plaintexts, size_t num_blocks);
+
+/* Memory encryption of 32-bit words with address-derived tweaks and a parallel tag array.
+   domain must be at most CHILOW_MEMORY_DOMAIN_MAX: encryption returns -1 for a larger one
+   (nothing written), decryption authenticates nothing */
+#define CHILOW_MEMORY_DOMAIN_SHIFT 56
+#define CHILOW_MEMORY_DOMAIN_MAX ((1ULL << (64 - CHILOW_MEMORY_DOMAIN_SHIFT)) - 1)
+uint64_t chilow_memory_tweak(uint64_t address, size_t index, uint64_t domain);
+int chilow_memory_encrypt_32bit(const chilow_ctx_t* ctx, uint64_t address, uint64_t domain,
+                                 const uint32_t* plaintexts, uint32_t* ciphertexts, uint32_t* tags,
+                                 size_t num_words);
+size_t chilow_memory_decrypt_32bit(const chilow_ctx_t* ctx, uint64_t address, uint64_t domain,
+                                   const uint32_t* ciphertexts, const uint32_t* tags,
+                                   uint32_t* plaintexts, size_t num_words);
+
+/* Counter-mode PRF / keystream generator (see chilow_prf_t) */
+void chilow_prf_init(chilow_prf_t* prf, const chilow_ctx_t* ctx, uint32_t nonce);
+void chilow_prf_seek(chilow_prf_t* prf, uint64_t position);
+void chilow_prf_generate(chilow_prf_t* prf, uint8_t* out, size_t num_bytes);
+
+/* Pointer authentication with ChiLow-40 (see chilow_pac_t) */
+void chilow_pac_sign_40bit(const chilow_ctx_t* ctx, const chilow_pac_t* pac, const uint64_t* pointers,
+                           const uint64_t* contexts, uint64_t* signed_pointers, size_t num_pointers);
+size_t chilow_pac_auth_40bit(const chilow_ctx_t* ctx, const chilow_pac_t* pac, const uint64_t* signed_pointers,
+                             const uint64_t* contexts, uint64_t* pointers, size_t num_pointers);
+
+/* Strided batch decryption over caller records (see chilow_strided_t) */
+void chilow_decrypt_32bit_strided(const chilow_strided_t* batch, size_t num_blocks);
+void chilow_decrypt_40bit_strided(const chilow_strided_t* batch, size_t num_blocks);
+
+/* Threaded bulk decryption under an expanded key (threads <= 0: all online cores) */
+void chilow_decrypt_32bit_bulk(const chilow_ctx_t* ctx, const uint32_t* ciphertexts,
+                               const uint64_t* tweaks, uint64_t* results, size_t num_blocks,
+                               int threads);
+void chilow_decrypt_40bit_bulk(const chilow_ctx_t* ctx, const uint64_t* ciphertexts,
+                               const uint64_t* tweaks, uint64_t* results, size_t num_blocks,
+                               int threads);
+void chilow_bulk_shutdown(void);
+
+/* Batch decryption with per-block keys (lane-parallel SIMD) */
+void chilow_decrypt_32bit_lanes(const uint32_t* ciphertexts, const uint64_t* tweaks,
+                                const uint64_t* keys_hi, const uint64_t* keys_lo,
+                                uint64_t* results, size_t num_blocks);
+void chilow_decrypt_40bit_lanes(const uint64_t* ciphertexts, const uint64_t* tweaks,
+                                const uint64_t* keys_hi, const uint64_t* keys_lo,
+                                uint64_t* results, size_t num_blocks);
+
+#endif /* CHILOW_H */
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <time.h>
+#include <limits.h>
 
 // Include the main ChiLow implementation
 #define NO_MAIN
@@ -32,10 +33,13 @@
 /* ========================================================================== */
 
 /**
- * Generate random 64-bit value
+ * SplitMix64: next value of a 64-bit generator state
  */
-static uint64_t random_uint64(void) {
-    return ((uint64_t)rand() << 32) | rand();
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
 /**
@@ -58,7 +62,8 @@ static int get_bit(uint64_t value, int position) {
 
 /**
  * Parse comma-separated list of integers
- * Returns number of integers parsed, fills the array
+ * Returns number of integers parsed, fills the array; -1 if an entry is not an
+ * integer or there are more than max_count entries
  */
 static int parse_int_list(const char* str, int* array, int max_count) {
     int count = 0;
@@ -66,8 +71,14 @@ static int parse_int_list(const char* str, int* array, int max_count) {
     strcpy(str_copy, str);
     
     char* token = strtok(str_copy, ",");
-    while (token != NULL && count < max_count) {
-        array[count] = atoi(token);
+    while (token != NULL) {
+        char* end;
+        long value = strtol(token, &end, 10);
+        if (end == token || *end != '\0' || count == max_count || value < INT_MIN || value > INT_MAX) {
+            count = -1;
+            break;
+        }
+        array[count] = (int)value;
         count++;
         token = strtok(NULL, ",");
     }
@@ -76,6 +87,26 @@ static int parse_int_list(const char* str, int* array, int max_count) {
     return count;
 }
 
+/**
+ * Check that bit positions lie in [0, width) and are distinct; prints the first problem
+ */
+static int validate_positions(const int* positions, int count, int width, const char* name) {
+    uint64_t seen = 0;
+    
+    for (int i = 0; i < count; i++) {
+        if (positions[i] < 0 || positions[i] >= width) {
+            printf("Error: %s position %d is outside 0-%d for this variant\n", name, positions[i], width - 1);
+            return 0;
+        }
+        if (get_bit(seen, positions[i])) {
+            printf("Error: %s position %d is listed twice\n", name, positions[i]);
+            return 0;
+        }
+        seen = set_bit(seen, positions[i], 1);
+    }
+    return 1;
+}
+
 /**
  * Print array of bit positions
  */
@@ -92,6 +123,267 @@ static void print_bit_positions(const int* positions, int count, const char* nam
     printf("\n");
 }
 
+/* ========================================================================== */
+/*                              REPETITIONS                                  */
+/* ========================================================================== */
+
+/*
+ * Repetitions are independent: repetition `rep` draws its fixed parts from a generator
+ * seeded with SplitMix64(master_seed + rep), so its cube sum does not depend on which
+ * thread runs it or in what order. Cubes larger than 2^CHUNK_BITS inputs are split into
+ * chunks of that many consecutive cube indices. Workers claim (repetition, chunk) items
+ * in order, so the chunks of one large cube run in parallel, and XOR each chunk's sums
+ * into the repetition's slot; counts and printouts are produced afterwards in repetition
+ * order. Progress and partial sums of chunked cubes go to stderr.
+ */
+typedef struct {
+    int first_rounds;           /* complete rounds to sum, first..last */
+    int last_rounds;            /* (equal unless scanning a range) */
+    const int* active_positions;
+    int num_active;
+    int use_40bit;
+    uint64_t master_seed;
+    uint64_t active_mask;
+    uint64_t chunks;            /* chunks per repetition */
+} integral_setup_t;
+
+/* XOR sums of one repetition, indexed by complete-round count */
+typedef uint64_t integral_sums_t[CHILOW_NUM_ROUNDS + 1];
+
+/* Cubes of at least this many inputs are summed on the bitsliced engine */
+#define BITSLICED_MIN_INPUTS 64
+
+/* Inputs per chunk of a large cube (2^CHUNK_BITS) */
+#define CHUNK_BITS 24
+
+/* Minimum interval between progress reports */
+#define PROGRESS_SECONDS 5
+
+/* Upper bound on worker threads (including the calling thread) */
+#define INTEGRAL_MAX_THREADS 64
+
+static void init_setup(integral_setup_t* setup, int first_rounds, int last_rounds,
+                       const int* active_positions, int num_active, int use_40bit, uint64_t master_seed) {
+    setup->first_rounds = first_rounds;
+    setup->last_rounds = last_rounds;
+    setup->active_positions = active_positions;
+    setup->num_active = num_active;
+    setup->use_40bit = use_40bit;
+    setup->master_seed = master_seed;
+    setup->active_mask = 0;
+    for (int i = 0; i < num_active; i++) {
+        setup->active_mask = set_bit(setup->active_mask, active_positions[i], 1);
+    }
+    setup->chunks = (num_active > CHUNK_BITS) ? 1ULL << (num_active - CHUNK_BITS) : 1;
+}
+
+/**
+ * Compute the cube sums of one chunk of one repetition
+ */
+static void run_chunk(const integral_setup_t* setup, int rep, uint64_t chunk, uint64_t* xor_sums) {
+    uint64_t seed = setup->master_seed + (uint64_t)rep;
+    uint64_t state = splitmix64(&seed);
+    uint64_t element;
+    chilow_cube_t cube;
+    
+    // Generate random values for fixed parts
+    uint32_t base_ciphertext_32 = (uint32_t)splitmix64(&state);
+    uint64_t base_ciphertext_40 = splitmix64(&state) & 0xFFFFFFFFFFULL;
+    uint64_t base_tweak = splitmix64(&state);
+    uint64_t base_key_hi = splitmix64(&state);
+    uint64_t base_key_lo = splitmix64(&state);
+    
+    memset(xor_sums, 0, sizeof(integral_sums_t));
+    if (chilow_cube_init(&cube, setup->use_40bit ? base_ciphertext_40 : base_ciphertext_32, setup->active_mask) != 0) {
+        return;  // full 64-bit mask, excluded by validate_positions
+    }
+    
+    if (cube.size >= BITSLICED_MIN_INPUTS) {
+        // Bitsliced cube sums, 512 inputs per pass, one pass over the chunk that folds a sum
+        // for every round count up to last_rounds (the tweak and key schedule is hoisted out)
+        uint64_t first = chunk << CHUNK_BITS, count = 1ULL << CHUNK_BITS;
+        uint64_t sums[CHILOW_NUM_ROUNDS + 1];
+        if (setup->use_40bit) {
+            chilow_cube_sum_40bit(&cube, first, count, base_tweak, base_key_hi, base_key_lo, setup->last_rounds, sums);
+        } else {
+            chilow_cube_sum_32bit(&cube, first, count, base_tweak, base_key_hi, base_key_lo, setup->last_rounds, sums);
+        }
+        for (int r = setup->first_rounds; r <= setup->last_rounds; r++) {
+            xor_sums[r] = sums[r];
+        }
+        return;
+    }
+    
+    // Small cubes (one chunk): enumerate the inputs in Gray-code order, one bit flip per input,
+    // and run only the state/tag path under the tweak and key schedule computed once here
+    chilow_integral_t integral;
+    if (setup->use_40bit) {
+        chilow_integral_init_40bit(&integral, base_tweak, base_key_hi, base_key_lo);
+    } else {
+        chilow_integral_init_32bit(&integral, base_tweak, base_key_hi, base_key_lo);
+    }
+    while (chilow_cube_next(&cube, &element)) {
+        uint64_t outputs[CHILOW_NUM_ROUNDS + 1];
+        
+        // Complete rounds for integral cryptanalysis, every round count up to last_rounds
+        if (setup->use_40bit) {
+            chilow_integral_rounds_40bit(&integral, element, setup->last_rounds, outputs);
+        } else {
+            chilow_integral_rounds_32bit(&integral, (uint32_t)element, setup->last_rounds, outputs);
+        }
+        for (int r = setup->first_rounds; r <= setup->last_rounds; r++) {
+            xor_sums[r] ^= outputs[r];
+        }
+    }
+}
+
+typedef struct {
+    const integral_setup_t* setup;
+    integral_sums_t* xor_sums;
+    uint64_t* chunks_done;      /* per repetition */
+    uint64_t items;             /* repetitions * chunks */
+    uint64_t next;              /* first unclaimed item, rep * chunks + chunk */
+    time_t last_report;
+#ifdef CHILOW_HAVE_PTHREADS
+    pthread_mutex_t lock;
+#endif
+} repetition_queue_t;
+
+/**
+ * Report a chunked repetition's progress and partial sums (caller holds the lock)
+ */
+static void report_progress(repetition_queue_t* queue, int rep) {
+    const integral_setup_t* setup = queue->setup;
+    uint64_t done = queue->chunks_done[rep];
+    time_t now = time(NULL);
+    
+    if (setup->chunks == 1 || (done < setup->chunks && now - queue->last_report < PROGRESS_SECONDS)) return;
+    queue->last_report = now;
+    fprintf(stderr, "  Repetition %d: %llu/%llu chunks (%.1f%%), partial XOR:", rep + 1,
+            (unsigned long long)done, (unsigned long long)setup->chunks, 100.0 * done / setup->chunks);
+    for (int r = setup->first_rounds; r <= setup->last_rounds; r++) {
+        fprintf(stderr, " %d:0x%016llX", r, (unsigned long long)queue->xor_sums[rep][r]);
+    }
+    fprintf(stderr, "\n");
+}
+
+static void* repetition_worker(void* arg) {
+    repetition_queue_t* queue = (repetition_queue_t*)arg;
+    const integral_setup_t* setup = queue->setup;
+    integral_sums_t partial;
+    
+    for (;;) {
+        uint64_t item;
+#ifdef CHILOW_HAVE_PTHREADS
+        pthread_mutex_lock(&queue->lock);
+#endif
+        item = queue->next++;
+#ifdef CHILOW_HAVE_PTHREADS
+        pthread_mutex_unlock(&queue->lock);
+#endif
+        if (item >= queue->items) break;
+        
+        int rep = (int)(item / setup->chunks);
+        run_chunk(setup, rep, item % setup->chunks, partial);
+        
+#ifdef CHILOW_HAVE_PTHREADS
+        pthread_mutex_lock(&queue->lock);
+#endif
+        for (int r = setup->first_rounds; r <= setup->last_rounds; r++) {
+            queue->xor_sums[rep][r] ^= partial[r];
+        }
+        queue->chunks_done[rep]++;
+        report_progress(queue, rep);
+#ifdef CHILOW_HAVE_PTHREADS
+        pthread_mutex_unlock(&queue->lock);
+#endif
+    }
+    return NULL;
+}
+
+/**
+ * Run all repetitions on the calling thread plus threads - 1 workers (threads <= 0: all
+ * online cores); returns the number of threads used
+ */
+static int run_repetitions(const integral_setup_t* setup, int repetitions, int threads,
+                           integral_sums_t* xor_sums, uint64_t* chunks_done) {
+    repetition_queue_t queue;
+    
+    memset(xor_sums, 0, sizeof(integral_sums_t) * (size_t)repetitions);
+    memset(chunks_done, 0, sizeof(uint64_t) * (size_t)repetitions);
+    queue.setup = setup;
+    queue.xor_sums = xor_sums;
+    queue.chunks_done = chunks_done;
+    queue.items = (uint64_t)repetitions * setup->chunks;
+    queue.next = 0;
+    queue.last_report = time(NULL);
+    
+#ifdef CHILOW_HAVE_PTHREADS
+    pthread_t workers[INTEGRAL_MAX_THREADS];
+    int started = 0;
+    
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+    if (threads > INTEGRAL_MAX_THREADS) threads = INTEGRAL_MAX_THREADS;
+    if ((uint64_t)threads > queue.items) threads = queue.items > 0 ? (int)queue.items : 1;
+    
+    pthread_mutex_init(&queue.lock, NULL);
+    while (started < threads - 1 &&
+           pthread_create(&workers[started], NULL, repetition_worker, &queue) == 0) {
+        started++;
+    }
+    repetition_worker(&queue);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    pthread_mutex_destroy(&queue.lock);
+    return started + 1;
+#else
+    (void)threads;
+    repetition_worker(&queue);
+    return 1;
+#endif
+}
+
+/**
+ * Allocate the per-repetition sums and run all repetitions; NULL if out of memory
+ */
+static integral_sums_t* compute_repetitions(const integral_setup_t* setup, int repetitions, int threads) {
+    integral_sums_t* xor_sums = malloc(sizeof(integral_sums_t) * (size_t)repetitions);
+    uint64_t* chunks_done = malloc(sizeof(uint64_t) * (size_t)repetitions);
+    
+    if (xor_sums == NULL || chunks_done == NULL) {
+        printf("Error: Cannot allocate sums for %d repetitions\n", repetitions);
+        free(xor_sums);
+        free(chunks_done);
+        return NULL;
+    }
+    printf("Threads: %d\n", run_repetitions(setup, repetitions, threads, xor_sums, chunks_done));
+    free(chunks_done);
+    return xor_sums;
+}
+
+static void print_setup(const integral_setup_t* setup, const int* balanced_positions, int num_balanced,
+                        int repetitions) {
+    printf("Variant: %s\n", setup->use_40bit ? "40-bit ChiLow" : "32-bit ChiLow");
+    if (setup->first_rounds == setup->last_rounds) {
+        printf("Rounds: %d\n", setup->first_rounds);
+    } else {
+        printf("Rounds: %d-%d\n", setup->first_rounds, setup->last_rounds);
+    }
+    print_bit_positions(setup->active_positions, setup->num_active, "Active");
+    print_bit_positions(balanced_positions, num_balanced, "Balanced");
+    printf("Repetitions: %d\n", repetitions);
+    printf("Inputs per set: %llu\n", 1ULL << setup->num_active);
+    if (setup->chunks > 1) {
+        printf("Chunks per set: %llu of 2^%d inputs (progress on stderr)\n",
+               (unsigned long long)setup->chunks, CHUNK_BITS);
+    }
+    printf("Master seed: %llu\n", (unsigned long long)setup->master_seed);
+}
+
 /* ========================================================================== */
 /*                              MAIN INTEGRAL TEST                           */
 /* ========================================================================== */
@@ -106,71 +398,28 @@ static void print_bit_positions(const int* positions, int count, const char* nam
  * @param num_balanced Number of balanced bits to check
  * @param repetitions Number of repetitions with random fixed parts
  * @param use_40bit 1 for 40-bit variant, 0 for 32-bit variant
+ * @param threads Worker threads (0 for all online cores)
+ * @param master_seed Seed of the per-repetition fixed parts
  * @return Number of repetitions where ALL balanced bits were actually balanced
  */
 static int test_integral_distinguisher(int rounds, const int* active_positions, int num_active,
                                      const int* balanced_positions, int num_balanced, 
-                                     int repetitions, int use_40bit) {
+                                     int repetitions, int use_40bit, int threads, uint64_t master_seed) {
     
+    integral_setup_t setup;
+    integral_sums_t* xor_sums;
     int successful_repetitions = 0;
-    int total_inputs = 1 << num_active;  // 2^num_active inputs per set
     
+    init_setup(&setup, rounds, rounds, active_positions, num_active, use_40bit, master_seed);
     printf("\nIntegral Distinguisher Test\n");
     printf("===========================\n");
-    printf("Variant: %s\n", use_40bit ? "40-bit ChiLow" : "32-bit ChiLow");
-    printf("Rounds: %d\n", rounds);
-    print_bit_positions(active_positions, num_active, "Active");
-    print_bit_positions(balanced_positions, num_balanced, "Balanced");
-    printf("Repetitions: %d\n", repetitions);
-    printf("Inputs per set: %d\n", total_inputs);
+    print_setup(&setup, balanced_positions, num_balanced, repetitions);
+    xor_sums = compute_repetitions(&setup, repetitions, threads);
+    if (xor_sums == NULL) return 0;
     printf("\n");
     
     for (int rep = 0; rep < repetitions; rep++) {
-        // Generate random values for fixed parts
-        uint32_t base_ciphertext_32 = (uint32_t)random_uint64();
-        uint64_t base_ciphertext_40 = random_uint64() & 0xFFFFFFFFFFULL;
-        uint64_t base_tweak = random_uint64();
-        uint64_t base_key_hi = random_uint64();
-        uint64_t base_key_lo = random_uint64();
-        
-        // Clear active bit positions in base values
-        for (int i = 0; i < num_active; i++) {
-            if (use_40bit) {
-                base_ciphertext_40 = set_bit(base_ciphertext_40, active_positions[i], 0);
-            } else {
-                base_ciphertext_32 = (uint32_t)set_bit(base_ciphertext_32, active_positions[i], 0);
-            }
-        }
-        
-        // Compute XOR sum over all possible active bit combinations
-        uint64_t xor_sum = 0;
-        
-        for (int input = 0; input < total_inputs; input++) {
-            uint32_t ciphertext_32 = base_ciphertext_32;
-            uint64_t ciphertext_40 = base_ciphertext_40;
-            
-            // Set active bits according to input pattern
-            for (int bit = 0; bit < num_active; bit++) {
-                int bit_value = (input >> bit) & 1;
-                if (use_40bit) {
-                    ciphertext_40 = set_bit(ciphertext_40, active_positions[bit], bit_value);
-                } else {
-                    ciphertext_32 = (uint32_t)set_bit(ciphertext_32, active_positions[bit], bit_value);
-                }
-            }
-            
-            // Compute ChiLow result using complete rounds for integral cryptanalysis
-            uint64_t result;
-            if (use_40bit) {
-                result = chilow_complete_rounds_40bit(ciphertext_40, base_tweak, 
-                                                     base_key_hi, base_key_lo, rounds);
-            } else {
-                result = chilow_complete_rounds_32bit(ciphertext_32, base_tweak, 
-                                                     base_key_hi, base_key_lo, rounds);
-            }
-            
-            xor_sum ^= result;
-        }
+        uint64_t xor_sum = xor_sums[rep][rounds];
         
         // Check if all specified balanced bits are actually balanced (zero)
         int all_balanced = 1;
@@ -212,6 +461,7 @@ static int test_integral_distinguisher(int rounds, const int* active_positions,
             printf("... (showing first 5 and last repetitions) ...\n");
         }
     }
+    free(xor_sums);
     
     printf("\nResults Summary:\n");
     printf("Successful repetitions: %d/%d (%.1f%%)\n", 
@@ -229,14 +479,67 @@ static int test_integral_distinguisher(int rounds, const int* active_positions,
     return successful_repetitions;
 }
 
+/**
+ * Test the same integral property over a range of round counts. Each cube input runs
+ * through last_rounds complete rounds once, and the sum of every round count in the
+ * range is taken from that single evaluation (chilow_integral_rounds_* outputs for small
+ * cubes, the per-round folds of chilow_cube_sum_* for bitsliced ones).
+ * 
+ * @param first_rounds Smallest number of rounds to test (1-8)
+ * @param last_rounds Largest number of rounds to test (first_rounds-8)
+ * @return Largest round count for which all repetitions were balanced, or 0 if none
+ */
+static int scan_integral_distinguisher(int first_rounds, int last_rounds,
+                                       const int* active_positions, int num_active,
+                                       const int* balanced_positions, int num_balanced,
+                                       int repetitions, int use_40bit, int threads, uint64_t master_seed) {
+    
+    integral_setup_t setup;
+    integral_sums_t* xor_sums;
+    int successful_repetitions[CHILOW_NUM_ROUNDS + 1] = {0};
+    int best_rounds = 0;
+    
+    init_setup(&setup, first_rounds, last_rounds, active_positions, num_active, use_40bit, master_seed);
+    printf("\nIntegral Distinguisher Round Scan\n");
+    printf("=================================\n");
+    print_setup(&setup, balanced_positions, num_balanced, repetitions);
+    xor_sums = compute_repetitions(&setup, repetitions, threads);
+    if (xor_sums == NULL) return 0;
+    printf("\n");
+    
+    for (int rep = 0; rep < repetitions; rep++) {
+        // Check the balanced bits separately for each round count
+        for (int r = first_rounds; r <= last_rounds; r++) {
+            int all_balanced = 1;
+            for (int i = 0; i < num_balanced; i++) {
+                if (get_bit(xor_sums[rep][r], balanced_positions[i]) != 0) {
+                    all_balanced = 0;
+                }
+            }
+            successful_repetitions[r] += all_balanced;
+        }
+    }
+    free(xor_sums);
+    
+    printf("Results Summary:\n");
+    for (int r = first_rounds; r <= last_rounds; r++) {
+        printf("  %d rounds: %d/%d successful repetitions (%.1f%%)%s\n",
+               r, successful_repetitions[r], repetitions,
+               100.0 * successful_repetitions[r] / repetitions,
+               (successful_repetitions[r] == repetitions) ? " [DISTINGUISHER]" : "");
+        if (successful_repetitions[r] == repetitions) {
+            best_rounds = r;
+        }
+    }
+    
+    return best_rounds;
+}
+
 /* ========================================================================== */
 /*                                 MAIN PROGRAM                              */
 /* ========================================================================== */
 
 int main(int argc, char* argv[]) {
-    // Initialize random seed
-    srand((unsigned int)time(NULL));
-    
     // Initialize ChiLow
     chilow_init();
     
@@ -245,13 +548,17 @@ int main(int argc, char* argv[]) {
     printf("Author: Hosein Hadipour <hsn.hadipour@gmail.com>\n");
     printf("License: GPL v3.0\n\n");
     
-    int rounds, repetitions, use_40bit = 0;
+    int rounds, repetitions, use_40bit = 0, threads = 0;
+    uint64_t master_seed = (uint64_t)time(NULL);
     int active_positions[64], balanced_positions[64];
     int num_active, num_balanced;
     
     if (argc >= 5) {
-        // Parse command line arguments
+        // Parse command line arguments ("<first>-<last>" scans a range of rounds)
+        int last_rounds;
+        const char* range = strchr(argv[1], '-');
         rounds = atoi(argv[1]);
+        last_rounds = (range != NULL) ? atoi(range + 1) : rounds;
         
         num_active = parse_int_list(argv[2], active_positions, 64);
         num_balanced = parse_int_list(argv[3], balanced_positions, 64);
@@ -260,12 +567,22 @@ int main(int argc, char* argv[]) {
         if (argc >= 6) {
             use_40bit = atoi(argv[5]);
         }
+        if (argc >= 7) {
+            threads = atoi(argv[6]);
+        }
+        if (argc >= 8) {
+            master_seed = strtoull(argv[7], NULL, 0);
+        }
         
         // Validate inputs
-        if (rounds < 1 || rounds > 8) {
+        if (rounds < 1 || rounds > 8 || last_rounds < rounds || last_rounds > 8) {
             printf("Error: Rounds must be between 1 and 8\n");
             return 1;
         }
+        if (num_active < 0 || num_balanced < 0) {
+            printf("Error: Bit positions must be comma-separated integers, at most 64 per list\n");
+            return 1;
+        }
         if (num_active == 0) {
             printf("Error: Must specify at least one active bit\n");
             return 1;
@@ -274,14 +591,25 @@ int main(int argc, char* argv[]) {
             printf("Error: Must specify at least one balanced bit to check\n");
             return 1;
         }
+        // Active bits are ciphertext bits; balanced bits are output bits (plaintext || tag for 32-bit)
+        if (!validate_positions(active_positions, num_active, use_40bit ? 40 : 32, "Active") ||
+            !validate_positions(balanced_positions, num_balanced, use_40bit ? 40 : 64, "Balanced")) {
+            return 1;
+        }
         if (repetitions < 1) {
             printf("Error: Repetitions must be at least 1\n");
             return 1;
         }
         
-        test_integral_distinguisher(rounds, active_positions, num_active,
-                                  balanced_positions, num_balanced, 
-                                  repetitions, use_40bit);
+        if (range != NULL) {
+            scan_integral_distinguisher(rounds, last_rounds, active_positions, num_active,
+                                        balanced_positions, num_balanced,
+                                        repetitions, use_40bit, threads, master_seed);
+        } else {
+            test_integral_distinguisher(rounds, active_positions, num_active,
+                                      balanced_positions, num_balanced, 
+                                      repetitions, use_40bit, threads, master_seed);
+        }
     } else {
         if (argc == 1) {
             // Default test case
@@ -298,26 +626,35 @@ int main(int argc, char* argv[]) {
             
             test_integral_distinguisher(rounds, active_positions, num_active,
                                       balanced_positions, num_balanced, 
-                                      repetitions, use_40bit);
+                                      repetitions, use_40bit, threads, master_seed);
         } else {
             // Show usage
-            printf("Usage: %s <rounds> <active_bits> <balanced_bits> <repetitions> [use_40bit]\n", argv[0]);
-            printf("  rounds:        Number of rounds (1-8)\n");
+            printf("Usage: %s <rounds> <active_bits> <balanced_bits> <repetitions> [use_40bit] [threads] [seed]\n", argv[0]);
+            printf("  rounds:        Number of rounds (1-8), or a range such as \"1-8\" to scan\n");
+            printf("                 every round count in one pass per input\n");
             printf("  active_bits:   Comma-separated list of active bit positions (e.g., \"0,1,2\")\n");
             printf("  balanced_bits: Comma-separated list of balanced bit positions (e.g., \"0,15,31\")\n");
             printf("  repetitions:   Number of repetitions with random fixed parts\n");
-            printf("  use_40bit:     1 for 40-bit variant, 0 for 32-bit variant (optional, default 0)\n\n");
+            printf("  use_40bit:     1 for 40-bit variant, 0 for 32-bit variant (optional, default 0)\n");
+            printf("  threads:       Worker threads, 0 for all online cores (optional, default 0)\n");
+            printf("  seed:          Master seed of the random fixed parts (optional, default time);\n");
+            printf("                 the same seed gives the same results for any thread count\n\n");
             
             printf("Bit Numbering Convention:\n");
             printf("  - Bit positions are counted from RIGHT to LEFT (LSB to MSB)\n");
             printf("  - Position 0 = rightmost bit (least significant)\n");
             printf("  - For 32-bit variant: positions 0-31 = plaintext, 32-63 = tag\n");
             printf("  - For 40-bit variant: positions 0-39 = output bits\n");
+            printf("  - Active bits are ciphertext bits: 0-31 (32-bit variant) or 0-39 (40-bit)\n");
+            printf("  - Cubes of more than 2^%d inputs run in chunks; progress and partial\n", CHUNK_BITS);
+            printf("    XOR sums are printed to stderr\n");
             printf("  - Example: 0x12345678 has bit 0=0, bit 1=0, bit 2=0, bit 3=1, etc.\n\n");
             
             printf("Examples:\n");
             printf("  %s 3 \"0,1\" \"0,15,30,31\" 10 0\n", argv[0]);
             printf("  %s 2 \"0\" \"31\" 100 1\n", argv[0]);
+            printf("  %s 1-4 \"21,23,25\" \"2,3,14,25,26\" 10 0\n", argv[0]);
+            printf("  %s 3 \"21,23,25\" \"2,3,14,25,26\" 1000 0 4 42\n", argv[0]);
             printf("\nTo run with default parameters, use: %s\n", argv[0]);
             return 1;
         }
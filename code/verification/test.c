@@ -27,14 +27,12 @@
 #include <string.h>
 #include <assert.h>
 
+#ifdef CHILOW_JIT
+#include <sys/stat.h>
+#endif
+
 /* Include our implementation */
-extern void chilow_init(void);
-extern uint64_t chilow_decrypt_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
-extern uint64_t chilow_decrypt_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo);
-extern uint64_t chilow_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
-extern uint64_t chilow_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
-extern uint64_t chilow_half_reduced_round_32bit(uint32_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
-extern uint64_t chilow_half_reduced_round_40bit(uint64_t ciphertext, uint64_t tweak, uint64_t key_hi, uint64_t key_lo, int num_rounds);
+#include "chilow.h"
 
 /* ========================================================================== */
 /*                              TEST VECTORS                                 */
@@ -151,6 +149,15 @@ static void test_40bit_vectors(void) {
     }
 }
 
+static void test_linear_layers(void) {
+    printf("\nLinear Layer Tests:\n");
+    printf("===================\n");
+    
+    int mismatches = chilow_check_linear_layers();
+    printf("  Layers differing from the reference matrices: %d\n", mismatches);
+    print_test_result("Linear layers match reference matrices", mismatches == 0);
+}
+
 static void test_edge_cases(void) {
     printf("\nBasic Functionality Tests:\n");
     printf("==========================\n");
@@ -177,6 +184,1095 @@ static void test_edge_cases(void) {
     printf("  Pattern 2: -> 0x%016llX\n", (unsigned long long)result2);
 }
 
+/* Deterministic generator for randomized cross-checks */
+static uint64_t test_rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t test_random(void) {
+    test_rng_state ^= test_rng_state << 13;
+    test_rng_state ^= test_rng_state >> 7;
+    test_rng_state ^= test_rng_state << 17;
+    return test_rng_state;
+}
+
+#define BATCH_TEST_MAX 1100
+
+static void test_bitsliced_batch(void) {
+    printf("\nBitsliced Batch Tests:\n");
+    printf("======================\n");
+    
+    static uint32_t c32[BATCH_TEST_MAX];
+    static uint64_t c40[BATCH_TEST_MAX], tweaks[BATCH_TEST_MAX];
+    static uint64_t out32[BATCH_TEST_MAX], out40[BATCH_TEST_MAX];
+    const size_t sizes[] = {1, 63, 64, 256, 512, 1100};
+    uint64_t key_hi = test_random();
+    uint64_t key_lo = test_random();
+    int passed = 1;
+    
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        int mismatches = 0;
+        
+        for (size_t i = 0; i < n; i++) {
+            c32[i] = (uint32_t)test_random();
+            c40[i] = test_random() & 0xFFFFFFFFFFULL;
+            tweaks[i] = test_random();
+        }
+        /* Specification vectors in the first lane */
+        c32[0] = test_vectors_32[0].ciphertext;
+        c40[0] = test_vectors_40[0].ciphertext;
+        tweaks[0] = test_vectors_32[0].tweak;
+        
+        chilow_decrypt_32bit_bitsliced(c32, tweaks, key_hi, key_lo, out32, n);
+        chilow_decrypt_40bit_bitsliced(c40, tweaks, key_hi, key_lo, out40, n);
+        
+        for (size_t i = 0; i < n; i++) {
+            if (out32[i] != chilow_decrypt_32bit(c32[i], tweaks[i], key_hi, key_lo)) mismatches++;
+            if (out40[i] != chilow_decrypt_40bit(c40[i], tweaks[i], key_hi, key_lo)) mismatches++;
+        }
+        
+        chilow_decrypt_32bit_bitsliced(c32, tweaks, test_vectors_32[0].key_hi,
+                                       test_vectors_32[0].key_lo, out32, n);
+        chilow_decrypt_40bit_bitsliced(c40, tweaks, test_vectors_40[0].key_hi,
+                                       test_vectors_40[0].key_lo, out40, n);
+        if (out32[0] != test_vectors_32[0].expected_result) mismatches++;
+        if (out40[0] != test_vectors_40[0].expected_result) mismatches++;
+        
+        printf("  %4zu blocks: %d mismatches\n", n, mismatches);
+        if (mismatches) passed = 0;
+    }
+    
+    print_test_result("Bitsliced batch matches scalar decryption", passed);
+}
+
+static void test_tag_verification(void) {
+    printf("\nTag Verification Tests:\n");
+    printf("=======================\n");
+    
+    static uint32_t c32[700], tags[700], plaintexts[700];
+    static uint64_t tweaks[700], bitmap[11];
+    const size_t sizes[] = {1, 63, 64, 65, 700};
+    uint64_t key_hi = test_random(), key_lo = test_random();
+    int mismatches = 0;
+    
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s], expected_count = 0;
+        
+        /* Every third block gets a corrupted tag (one flipped bit) */
+        for (size_t i = 0; i < n; i++) {
+            c32[i] = (uint32_t)test_random();
+            tweaks[i] = test_random();
+            tags[i] = (uint32_t)(chilow_decrypt_32bit(c32[i], tweaks[i], key_hi, key_lo) >> 32);
+            if (i % 3 == 1) tags[i] ^= 1u << (i % 32);
+            plaintexts[i] = 0xDEADBEEF;
+        }
+        memset(bitmap, 0xFF, sizeof bitmap);
+        
+        size_t count = chilow_verify_32bit_batch(c32, tweaks, tags, key_hi, key_lo, bitmap, plaintexts, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t result = chilow_decrypt_32bit(c32[i], tweaks[i], key_hi, key_lo);
+            uint32_t single = 0xDEADBEEF;
+            int valid = i % 3 != 1;
+            expected_count += (size_t)valid;
+            if ((int)((bitmap[i / 64] >> (i % 64)) & 1) != valid) mismatches++;
+            if (plaintexts[i] != (valid ? (uint32_t)result : 0xDEADBEEF)) mismatches++;
+            if (chilow_verify_32bit(c32[i], tweaks[i], tags[i], key_hi, key_lo, &single) != valid) mismatches++;
+            if (single != (valid ? (uint32_t)result : 0xDEADBEEF)) mismatches++;
+        }
+        if (n % 64 != 0 && (bitmap[n / 64] >> (n % 64)) != 0) mismatches++;
+        if (count != expected_count) mismatches++;
+        
+        /* Bitmap only */
+        if (chilow_verify_32bit_batch(c32, tweaks, tags, key_hi, key_lo, bitmap, NULL, n) != expected_count) mismatches++;
+    }
+    
+    printf("  Mismatches in bitmaps, plaintexts and counts: %d\n", mismatches);
+    print_test_result("Tag verification matches decryption", mismatches == 0);
+}
+
+static void test_memory_encryption(void) {
+    printf("\nMemory Encryption Tests:\n");
+    printf("========================\n");
+    
+    static uint32_t plaintexts[1100], ciphertexts[1100], tags[1100], decrypted[1100];
+    const size_t sizes[] = {0, 1, 7, 1024, 1100};
+    const uint64_t address = 0x7F3A12345676ULL, domain = 0x5A;
+    chilow_ctx_t ctx;
+    int mismatches = 0;
+    
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        
+        for (size_t i = 0; i < n; i++) plaintexts[i] = (uint32_t)test_random();
+        chilow_memory_encrypt_32bit(&ctx, address, domain, plaintexts, ciphertexts, tags, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t tweak = chilow_memory_tweak(address, i, domain);
+            uint64_t expected = chilow_encrypt_32bit(plaintexts[i], tweak, ctx.key_hi, ctx.key_lo);
+            if (ciphertexts[i] != (uint32_t)expected || tags[i] != (uint32_t)(expected >> 32)) mismatches++;
+        }
+        if (chilow_memory_decrypt_32bit(&ctx, address, domain, ciphertexts, tags, decrypted, n) != 0) mismatches++;
+        if (n && memcmp(decrypted, plaintexts, n * sizeof(uint32_t)) != 0) mismatches++;
+        
+        /* In place, then one tampered word and one tampered tag */
+        memcpy(decrypted, plaintexts, n * sizeof(uint32_t));
+        chilow_memory_encrypt_32bit(&ctx, address, domain, decrypted, decrypted, tags, n);
+        if (n && memcmp(decrypted, ciphertexts, n * sizeof(uint32_t)) != 0) mismatches++;
+        if (n >= 7) {
+            decrypted[3] ^= 0x100;
+            tags[n - 1] ^= 0x80000000u;
+            if (chilow_memory_decrypt_32bit(&ctx, address, domain, decrypted, tags, decrypted, n) != 2) mismatches++;
+            for (size_t i = 0; i < n; i++) {
+                uint32_t expected = (i == 3 || i == n - 1) ? 0 : plaintexts[i];
+                if (decrypted[i] != expected) mismatches++;
+            }
+            
+            /* Another domain or address authenticates nothing */
+            tags[n - 1] ^= 0x80000000u;
+            if (chilow_memory_decrypt_32bit(&ctx, address, domain ^ 1, ciphertexts, tags, decrypted, n) != n) mismatches++;
+            if (chilow_memory_decrypt_32bit(&ctx, address + 4, domain, ciphertexts, tags, decrypted, n) != n) mismatches++;
+        }
+    }
+    if (chilow_memory_tweak(address, 3, domain) != (((address + 12) & 0x00FFFFFFFFFFFFFFULL) | (domain << 56))) mismatches++;
+    
+    /* Domains wider than 8 bits would alias in the tweak and are rejected */
+    memcpy(decrypted, plaintexts, 7 * sizeof(uint32_t));
+    if (chilow_memory_encrypt_32bit(&ctx, address, CHILOW_MEMORY_DOMAIN_MAX + 1 + domain, decrypted, decrypted,
+                                    tags, 7) != -1) mismatches++;
+    if (memcmp(decrypted, plaintexts, 7 * sizeof(uint32_t)) != 0) mismatches++;
+    if (chilow_memory_encrypt_32bit(&ctx, address, domain, plaintexts, ciphertexts, tags, 7) != 0) mismatches++;
+    if (chilow_memory_decrypt_32bit(&ctx, address, CHILOW_MEMORY_DOMAIN_MAX + 1 + domain, ciphertexts, tags,
+                                    decrypted, 7) != 7) mismatches++;
+    for (size_t i = 0; i < 7; i++) {
+        if (decrypted[i] != 0) mismatches++;
+    }
+    
+    printf("  Mismatches against scalar encryption and expected failures: %d\n", mismatches);
+    print_test_result("Memory encryption round-trips and authenticates", mismatches == 0);
+}
+
+static void test_pointer_authentication(void) {
+    printf("\nPointer Authentication Tests:\n");
+    printf("=============================\n");
+    
+    static uint64_t pointers[1100], contexts[1100], signed_pointers[1100], restored[1100];
+    const size_t sizes[] = {0, 1, 9, 1100};
+    const chilow_pac_t pac = {0xFFFF000000000000ULL, 0xA5C3000000000000ULL, 0xF};
+    chilow_ctx_t ctx;
+    int mismatches = 0;
+    size_t forged = 0, tampered = 0;
+    
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        
+        /* 16-byte aligned user-space pointers (47 bits) */
+        for (size_t i = 0; i < n; i++) {
+            pointers[i] = test_random() & 0x00007FFFFFFFFFF0ULL;
+            contexts[i] = test_random();
+        }
+        chilow_pac_sign_40bit(&ctx, &pac, pointers, contexts, signed_pointers, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t high = (pointers[i] & 0x0000FF0000000000ULL) | pac.check;
+            uint64_t low = chilow_encrypt_40bit(pointers[i] & 0xFFFFFFFFFFULL, contexts[i] ^ high,
+                                                ctx.key_hi, ctx.key_lo);
+            if (signed_pointers[i] != (high | low)) mismatches++;
+        }
+        if (chilow_pac_auth_40bit(&ctx, &pac, signed_pointers, contexts, restored, n) != 0) mismatches++;
+        if (n && memcmp(restored, pointers, n * sizeof(uint64_t)) != 0) mismatches++;
+        
+        /* In place; then a wrong context, check field and upper bit on three pointers */
+        memcpy(restored, pointers, n * sizeof(uint64_t));
+        chilow_pac_sign_40bit(&ctx, &pac, restored, contexts, restored, n);
+        if (n && memcmp(restored, signed_pointers, n * sizeof(uint64_t)) != 0) mismatches++;
+        if (n >= 9) {
+            contexts[2] ^= 1;
+            restored[5] ^= 1ULL << 60;
+            restored[8] ^= 1ULL << 44;
+            forged += chilow_pac_auth_40bit(&ctx, &pac, restored, contexts, restored, n);
+            tampered += 3;
+            if (restored[5] != 0 || restored[2] == pointers[2] || restored[8] == pointers[8]) mismatches++;
+            for (size_t i = 0; i < n; i++) {
+                if (i != 2 && i != 5 && i != 8 && restored[i] != pointers[i]) mismatches++;
+            }
+        }
+    }
+    
+    /* A wrong check field is always rejected; a garbled address passes the 4 zero bits
+       with probability 1/16 but never decrypts to the original pointer */
+    printf("  Rejected tampered pointers: %zu of %zu, mismatches: %d\n", forged, tampered, mismatches);
+    print_test_result("Pointer authentication round-trips and rejects tampering", mismatches == 0);
+}
+
+static void test_prf_keystream(void) {
+    printf("\nCounter-Mode PRF Tests:\n");
+    printf("=======================\n");
+    
+    static uint8_t stream[5000], pieces[5000];
+    const size_t splits[] = {1, 3, 4, 7, 2048, 1, 2936};
+    const uint32_t nonce = 0x1234ABCD;
+    chilow_ctx_t ctx;
+    chilow_prf_t prf;
+    int mismatches = 0;
+    
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    chilow_prf_init(&prf, &ctx, nonce);
+    chilow_prf_generate(&prf, stream, sizeof stream);
+    for (size_t block = 0; block < sizeof stream / 4; block++) {
+        uint64_t tag = chilow_decrypt_32bit((uint32_t)block, (uint64_t)nonce << 32, ctx.key_hi, ctx.key_lo) >> 32;
+        for (int b = 0; b < 4; b++) {
+            if (stream[4 * block + b] != (uint8_t)(tag >> (8 * b))) mismatches++;
+        }
+    }
+    if (prf.position != sizeof stream) mismatches++;
+    
+    /* Same bytes when split into uneven calls, and after seeking */
+    chilow_prf_init(&prf, &ctx, nonce);
+    for (size_t i = 0, done = 0; i < sizeof(splits) / sizeof(splits[0]); done += splits[i++]) {
+        chilow_prf_generate(&prf, pieces + done, splits[i]);
+    }
+    if (memcmp(stream, pieces, sizeof stream) != 0) mismatches++;
+    chilow_prf_seek(&prf, 1001);
+    chilow_prf_generate(&prf, pieces, 1234);
+    if (memcmp(stream + 1001, pieces, 1234) != 0) mismatches++;
+    
+    /* Block counter crossing 2^32 moves into the tweak */
+    chilow_prf_seek(&prf, 4 * 0xFFFFFFFEULL + 2);
+    chilow_prf_generate(&prf, pieces, 10);
+    for (size_t i = 0; i < 10; i++) {
+        uint64_t block = 0xFFFFFFFEULL + (i + 2) / 4;
+        uint64_t tweak = ((uint64_t)nonce << 32) | (block >> 32);
+        uint64_t tag = chilow_decrypt_32bit((uint32_t)block, tweak, ctx.key_hi, ctx.key_lo) >> 32;
+        if (pieces[i] != (uint8_t)(tag >> (8 * ((i + 2) % 4)))) mismatches++;
+    }
+    
+    /* Another nonce gives another stream */
+    chilow_prf_init(&prf, &ctx, nonce + 1);
+    chilow_prf_generate(&prf, pieces, 64);
+    if (memcmp(stream, pieces, 64) == 0) mismatches++;
+    
+    printf("  Mismatches against chilow_decrypt_32bit tags: %d\n", mismatches);
+    print_test_result("Counter-mode PRF keystream", mismatches == 0);
+}
+
+static void test_strided_batch(void) {
+    printf("\nStrided Batch Tests:\n");
+    printf("====================\n");
+    
+    /* Record layout with unaligned fields; the 40-bit result overwrites the ciphertext */
+    typedef struct {
+        uint8_t flags;
+        uint8_t ciphertext[8];
+        uint64_t tweak;
+        uint64_t key_hi, key_lo;
+        uint8_t tag[8];
+    } record_t;
+    static record_t records[1100];
+    static uint64_t c40[1100];
+    const size_t sizes[] = {0, 1, 513, 1100};
+    uint64_t key_hi = test_random(), key_lo = test_random();
+    int mismatches = 0;
+    
+    for (int variant_40 = 0; variant_40 < 2; variant_40++) {
+        for (int shared_key = 0; shared_key < 2; shared_key++) {
+            for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+                size_t n = sizes[s];
+                chilow_strided_t batch = {
+                    records[0].ciphertext, sizeof(record_t),
+                    &records[0].tweak, sizeof(record_t),
+                    shared_key ? &key_hi : &records[0].key_hi,
+                    shared_key ? &key_lo : &records[0].key_lo,
+                    shared_key ? 0 : sizeof(record_t),
+                    variant_40 ? (void*)records[0].ciphertext : (void*)records[0].tag, sizeof(record_t)
+                };
+                
+                for (size_t i = 0; i < n; i++) {
+                    uint64_t c = test_random() & 0xFFFFFFFFFFULL;
+                    c40[i] = c;
+                    memcpy(records[i].ciphertext, &c, sizeof c);
+                    records[i].tweak = test_random();
+                    records[i].key_hi = test_random();
+                    records[i].key_lo = test_random();
+                }
+                if (variant_40) {
+                    chilow_decrypt_40bit_strided(&batch, n);
+                } else {
+                    chilow_decrypt_32bit_strided(&batch, n);
+                }
+                for (size_t i = 0; i < n; i++) {
+                    uint64_t result, expected;
+                    uint64_t k_hi = shared_key ? key_hi : records[i].key_hi;
+                    uint64_t k_lo = shared_key ? key_lo : records[i].key_lo;
+                    if (variant_40) {
+                        memcpy(&result, records[i].ciphertext, sizeof result);
+                        expected = chilow_decrypt_40bit(c40[i], records[i].tweak, k_hi, k_lo);
+                    } else {
+                        memcpy(&result, records[i].tag, sizeof result);
+                        expected = chilow_decrypt_32bit((uint32_t)c40[i], records[i].tweak, k_hi, k_lo);
+                    }
+                    if (result != expected) mismatches++;
+                }
+            }
+        }
+    }
+    
+    printf("  Mismatches against scalar decryption (shared/per-record keys): %d\n", mismatches);
+    print_test_result("Strided batch matches scalar decryption", mismatches == 0);
+}
+
+static void test_bulk_decryption(void) {
+    printf("\nThreaded Bulk Decryption Tests:\n");
+    printf("===============================\n");
+    
+    static uint32_t c32[3 * 4096 + 7];
+    static uint64_t c40[3 * 4096 + 7], tweaks[3 * 4096 + 7], out[3 * 4096 + 7];
+    const size_t sizes[] = {0, 1, 513, 4096, 3 * 4096 + 7};
+    const int thread_counts[] = {1, 2, 3, 0};
+    chilow_ctx_t ctx;
+    int mismatches = 0;
+    
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    for (size_t i = 0; i < 3 * 4096 + 7; i++) {
+        c32[i] = (uint32_t)test_random();
+        c40[i] = test_random() & 0xFFFFFFFFFFULL;
+        tweaks[i] = test_random();
+    }
+    
+    /* The second pass runs after chilow_bulk_shutdown(), so the pool is rebuilt */
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            for (size_t k = 0; k < sizeof(thread_counts) / sizeof(thread_counts[0]); k++) {
+                size_t n = sizes[s];
+                chilow_decrypt_32bit_bulk(&ctx, c32, tweaks, out, n, thread_counts[k]);
+                for (size_t i = 0; i < n; i++) {
+                    if (out[i] != chilow_ctx_decrypt_32bit(&ctx, c32[i], tweaks[i])) mismatches++;
+                }
+                chilow_decrypt_40bit_bulk(&ctx, c40, tweaks, out, n, thread_counts[k]);
+                for (size_t i = 0; i < n; i++) {
+                    if (out[i] != chilow_ctx_decrypt_40bit(&ctx, c40[i], tweaks[i])) mismatches++;
+                }
+            }
+        }
+        chilow_bulk_shutdown();
+    }
+    
+    printf("  Mismatches against chilow_ctx_decrypt (1/2/3/all threads): %d\n", mismatches);
+    print_test_result("Bulk decryption matches context decryption", mismatches == 0);
+}
+
+static void test_lane_batch(void) {
+    printf("\nLane-Parallel Batch Tests:\n");
+    printf("==========================\n");
+    
+    static uint32_t c32[BATCH_TEST_MAX];
+    static uint64_t c40[BATCH_TEST_MAX], tweaks[BATCH_TEST_MAX];
+    static uint64_t keys_hi[BATCH_TEST_MAX], keys_lo[BATCH_TEST_MAX];
+    static uint64_t out32[BATCH_TEST_MAX], out40[BATCH_TEST_MAX];
+    const size_t sizes[] = {1, 4, 8, 13, 64, 1100};
+    int passed = 1;
+    
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        int mismatches = 0;
+        
+        for (size_t i = 0; i < n; i++) {
+            c32[i] = (uint32_t)test_random();
+            c40[i] = test_random() & 0xFFFFFFFFFFULL;
+            tweaks[i] = test_random();
+            keys_hi[i] = test_random();
+            keys_lo[i] = test_random();
+        }
+        /* Specification vectors in the first lane */
+        c32[0] = test_vectors_32[0].ciphertext;
+        tweaks[0] = test_vectors_32[0].tweak;
+        keys_hi[0] = test_vectors_32[0].key_hi;
+        keys_lo[0] = test_vectors_32[0].key_lo;
+        
+        chilow_decrypt_32bit_lanes(c32, tweaks, keys_hi, keys_lo, out32, n);
+        c40[0] = test_vectors_40[0].ciphertext;
+        chilow_decrypt_40bit_lanes(c40, tweaks, keys_hi, keys_lo, out40, n);
+        
+        if (out32[0] != test_vectors_32[0].expected_result) mismatches++;
+        if (out40[0] != test_vectors_40[0].expected_result) mismatches++;
+        for (size_t i = 0; i < n; i++) {
+            if (out32[i] != chilow_decrypt_32bit(c32[i], tweaks[i], keys_hi[i], keys_lo[i])) mismatches++;
+            if (out40[i] != chilow_decrypt_40bit(c40[i], tweaks[i], keys_hi[i], keys_lo[i])) mismatches++;
+        }
+        
+        printf("  %4zu blocks: %d mismatches\n", n, mismatches);
+        if (mismatches) passed = 0;
+    }
+    
+    print_test_result("Lane-parallel batch matches scalar decryption", passed);
+}
+
+static void test_expanded_key_context(void) {
+    printf("\nExpanded-Key Context Tests:\n");
+    printf("===========================\n");
+    
+    chilow_ctx_t ctx;
+    int mismatches = 0;
+    
+    chilow_ctx_init(&ctx, test_vectors_32[0].key_hi, test_vectors_32[0].key_lo);
+    if (chilow_ctx_decrypt_32bit(&ctx, test_vectors_32[0].ciphertext, test_vectors_32[0].tweak) !=
+        test_vectors_32[0].expected_result) mismatches++;
+    if (chilow_ctx_decrypt_40bit(&ctx, test_vectors_40[0].ciphertext, test_vectors_40[0].tweak) !=
+        test_vectors_40[0].expected_result) mismatches++;
+    
+    for (int trial = 0; trial < 64; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        uint32_t c32 = (uint32_t)test_random();
+        uint64_t c40 = test_random() & 0xFFFFFFFFFFULL;
+        
+        chilow_ctx_init(&ctx, key_hi, key_lo);
+        if (chilow_ctx_decrypt_32bit(&ctx, c32, tweak) != chilow_decrypt_32bit(c32, tweak, key_hi, key_lo)) mismatches++;
+        if (chilow_ctx_decrypt_40bit(&ctx, c40, tweak) != chilow_decrypt_40bit(c40, tweak, key_hi, key_lo)) mismatches++;
+        
+        for (int rounds = 1; rounds <= 8; rounds++) {
+            if (chilow_ctx_reduced_round_32bit(&ctx, c32, tweak, rounds) !=
+                chilow_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (chilow_ctx_reduced_round_40bit(&ctx, c40, tweak, rounds) !=
+                chilow_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (chilow_ctx_half_reduced_round_32bit(&ctx, c32, tweak, rounds) !=
+                chilow_half_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (chilow_ctx_half_reduced_round_40bit(&ctx, c40, tweak, rounds) !=
+                chilow_half_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (chilow_ctx_complete_rounds_32bit(&ctx, c32, tweak, rounds) !=
+                chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (chilow_ctx_complete_rounds_40bit(&ctx, c40, tweak, rounds) !=
+                chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+        }
+    }
+    
+    printf("  Mismatches against the key-per-call API: %d\n", mismatches);
+    print_test_result("Expanded-key context matches key-per-call API", mismatches == 0);
+}
+
+static void test_round_sweep(void) {
+    printf("\nRound Sweep Tests:\n");
+    printf("==================\n");
+    
+    chilow_ctx_t ctx;
+    chilow_round_sweep_t sweep32, sweep40, ctx_sweep32, ctx_sweep40;
+    int mismatches = 0;
+    
+    for (int trial = 0; trial < 64; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        uint32_t c32 = (uint32_t)test_random();
+        uint64_t c40 = test_random() & 0xFFFFFFFFFFULL;
+        
+        chilow_ctx_init(&ctx, key_hi, key_lo);
+        chilow_round_sweep_32bit(c32, tweak, key_hi, key_lo, &sweep32);
+        chilow_round_sweep_40bit(c40, tweak, key_hi, key_lo, &sweep40);
+        chilow_ctx_round_sweep_32bit(&ctx, c32, tweak, &ctx_sweep32);
+        chilow_ctx_round_sweep_40bit(&ctx, c40, tweak, &ctx_sweep40);
+        
+        for (int rounds = 0; rounds <= 8; rounds++) {
+            if (sweep32.reduced[rounds] != chilow_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (sweep40.reduced[rounds] != chilow_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (sweep32.half_reduced[rounds] != chilow_half_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (sweep40.half_reduced[rounds] != chilow_half_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (sweep32.complete[rounds] != chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, rounds)) mismatches++;
+            if (sweep40.complete[rounds] != chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, rounds)) mismatches++;
+        }
+        if (memcmp(&sweep32, &ctx_sweep32, sizeof(sweep32)) != 0) mismatches++;
+        if (memcmp(&sweep40, &ctx_sweep40, sizeof(sweep40)) != 0) mismatches++;
+    }
+    
+    printf("  Mismatches against the per-round-count API: %d\n", mismatches);
+    print_test_result("Round sweep matches per-round-count API", mismatches == 0);
+}
+
+static void test_round_trace(void) {
+    printf("\nRound-State Capture Tests:\n");
+    printf("==========================\n");
+    
+    chilow_ctx_t ctx;
+    chilow_trace_t trace32, trace40;
+    int mismatches = 0;
+    
+    for (int trial = 0; trial < 64; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        uint32_t c32 = (uint32_t)test_random();
+        uint64_t c40 = test_random() & 0xFFFFFFFFFFULL;
+        
+        chilow_ctx_init(&ctx, key_hi, key_lo);
+        if (chilow_trace_decrypt_32bit(c32, tweak, key_hi, key_lo, &trace32) !=
+            chilow_decrypt_32bit(c32, tweak, key_hi, key_lo)) mismatches++;
+        if (chilow_trace_decrypt_40bit(c40, tweak, key_hi, key_lo, &trace40) !=
+            chilow_decrypt_40bit(c40, tweak, key_hi, key_lo)) mismatches++;
+        
+        /* Whitening and every interaction layer agree with the complete-round outputs */
+        if (((trace32.whitening.tag << 32) | trace32.whitening.plaintext) !=
+            chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, 0)) mismatches++;
+        if (trace40.whitening.plaintext != chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, 0)) mismatches++;
+        for (int round = 0; round < 7; round++) {
+            const chilow_state_t* s32 = &trace32.rounds[round].interaction;
+            const chilow_state_t* s40 = &trace40.rounds[round].interaction;
+            if (((s32->tag << 32) | s32->plaintext) !=
+                chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, round + 1)) mismatches++;
+            if (s40->plaintext != chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, round + 1)) mismatches++;
+            if (s32->key_lo != ctx.round_keys_32[round] || s40->key_lo != ctx.round_keys_40[round]) mismatches++;
+            
+            /* The nonlinear and linear layers leave the key path in step with the cipher */
+            if (trace32.rounds[round].linear.key_hi != s32->key_hi) mismatches++;
+            if (trace32.rounds[round].nonlinear.tweak == trace32.rounds[round].linear.tweak) mismatches++;
+        }
+        
+        /* Final round: the tweak linear layer only, key unchanged */
+        const chilow_round_trace_t* final32 = &trace32.rounds[7];
+        if (final32->nonlinear.key_lo != trace32.rounds[6].interaction.key_lo) mismatches++;
+        if (final32->nonlinear.plaintext != final32->linear.plaintext) mismatches++;
+        if (((final32->interaction.tag << 32) | final32->interaction.plaintext) !=
+            chilow_decrypt_32bit(c32, tweak, key_hi, key_lo)) mismatches++;
+        if (trace40.rounds[7].interaction.plaintext != chilow_decrypt_40bit(c40, tweak, key_hi, key_lo)) mismatches++;
+    }
+    
+    printf("  Mismatches against the reduced-round API: %d\n", mismatches);
+    print_test_result("Round-state capture matches decryption", mismatches == 0);
+}
+
+static void test_cube_enumerator(void) {
+    printf("\nCube Enumerator Tests:\n");
+    printf("======================\n");
+    
+    static const char* const names[] = {"scalar", "bmi2"};
+    static uint64_t elements[1 << 12], filled[1 << 12];
+    static uint8_t seen[1 << 12];
+    const char* selected = chilow_kernel_name();
+    chilow_cube_t cube;
+    int mismatches = 0;
+    
+    for (int trial = 0; trial < 16; trial++) {
+        /* 12 distinct active positions */
+        uint64_t mask = 0, base = test_random();
+        while (__builtin_popcountll(mask) < 12) mask |= 1ULL << (test_random() % 64);
+        
+        if (chilow_cube_init(&cube, base, mask) != 0 || cube.size != (1 << 12)) mismatches++;
+        size_t count = 0;
+        while (chilow_cube_next(&cube, &elements[count])) count++;
+        if (count != cube.size) mismatches++;
+        
+        /* Fixed part kept, every element once, one active bit flipped per step */
+        memset(seen, 0, sizeof(seen));
+        for (size_t i = 0; i < count; i++) {
+            uint64_t active = 0;
+            for (int j = 0; j < 12; j++) {
+                active |= ((elements[i] >> cube.positions[j]) & 1) << j;
+            }
+            if ((elements[i] & ~mask) != (base & ~mask) || seen[active]++) mismatches++;
+            if (i > 0 && (__builtin_popcountll(elements[i] ^ elements[i - 1]) != 1 ||
+                          ((elements[i] ^ elements[i - 1]) & ~mask))) mismatches++;
+        }
+        
+        /* Random access, seeking and filling in uneven pieces, with and without PDEP */
+        for (int k = 0; k < 2; k++) {
+            if (chilow_set_kernel(names[k]) != 0) continue;
+            for (size_t i = 0; i < count; i += 37) {
+                if (chilow_cube_element(&cube, i) != elements[i]) mismatches++;
+            }
+            size_t start = (size_t)(test_random() % count), done = start;
+            chilow_cube_seek(&cube, start);
+            while (done < count) done += chilow_cube_fill(&cube, filled + done, 1 + done % 300);
+            if (done != count || chilow_cube_fill(&cube, filled, 1) != 0 ||
+                memcmp(filled + start, elements + start, (count - start) * sizeof(uint64_t)) != 0) mismatches++;
+        }
+        chilow_set_kernel(selected);
+    }
+    if (chilow_cube_init(&cube, 0, ~0ULL) != -1) mismatches++;
+    
+    printf("  Mismatches against the Gray-code definition: %d\n", mismatches);
+    print_test_result("Cube enumerator visits every element in Gray-code order", mismatches == 0);
+}
+
+static void test_cube_sum(void) {
+    printf("\nBitsliced Cube Sum Tests:\n");
+    printf("=========================\n");
+    
+    static const char* const names[] = {"scalar", "avx512"};
+    static const int sizes[] = {3, 6, 9, 11};
+    const char* selected = chilow_kernel_name();
+    chilow_cube_t cube;
+    int mismatches = 0;
+    
+    for (int trial = 0; trial < 16; trial++) {
+        int variant_40 = trial & 1, width = variant_40 ? 40 : 32, rounds = trial % 9;
+        uint64_t mask = 0, base = test_random(), tweak = test_random();
+        uint64_t key_hi = test_random(), key_lo = test_random();
+        while (__builtin_popcountll(mask) < sizes[trial % 4]) mask |= 1ULL << (test_random() % width);
+        chilow_cube_init(&cube, base, mask);
+        
+        /* Whole cube and an unaligned range, against element-by-element sums of every round count */
+        uint64_t first = test_random() % cube.size, count = test_random() % (cube.size - first + 1);
+        uint64_t whole[CHILOW_NUM_ROUNDS + 1] = {0}, range[CHILOW_NUM_ROUNDS + 1] = {0};
+        uint64_t sums[CHILOW_NUM_ROUNDS + 1];
+        for (uint64_t i = 0; i < cube.size; i++) {
+            uint64_t element = chilow_cube_element(&cube, i);
+            for (int r = 0; r <= rounds; r++) {
+                uint64_t out = variant_40 ? chilow_complete_rounds_40bit(element, tweak, key_hi, key_lo, r)
+                                          : chilow_complete_rounds_32bit((uint32_t)element, tweak, key_hi, key_lo, r);
+                whole[r] ^= out;
+                if (i >= first && i < first + count) range[r] ^= out;
+            }
+        }
+        for (int k = 0; k < 2; k++) {
+            if (chilow_set_kernel(names[k]) != 0) continue;
+            for (int part = 0; part < 2; part++) {
+                uint64_t part_first = part ? first : 0, part_count = part ? count : cube.size;
+                const uint64_t* expected = part ? range : whole;
+                uint64_t sum = variant_40
+                    ? chilow_cube_sum_40bit(&cube, part_first, part_count, tweak, key_hi, key_lo, rounds, NULL)
+                    : chilow_cube_sum_32bit(&cube, part_first, part_count, tweak, key_hi, key_lo, rounds, NULL);
+                if (sum != expected[rounds]) mismatches++;
+                
+                /* Every round count from one pass */
+                if (variant_40) {
+                    chilow_cube_sum_40bit(&cube, part_first, part_count, tweak, key_hi, key_lo, rounds, sums);
+                } else {
+                    chilow_cube_sum_32bit(&cube, part_first, part_count, tweak, key_hi, key_lo, rounds, sums);
+                }
+                for (int r = 0; r <= rounds; r++) {
+                    if (sums[r] != expected[r]) mismatches++;
+                }
+            }
+        }
+        chilow_set_kernel(selected);
+    }
+    
+    printf("  Mismatches against per-element complete rounds: %d\n", mismatches);
+    print_test_result("Bitsliced cube sums match per-element sums", mismatches == 0);
+}
+
+static void test_integral_schedule(void) {
+    printf("\nIntegral Schedule Tests:\n");
+    printf("========================\n");
+    
+    chilow_integral_t integral32, integral40;
+    uint64_t outputs32[CHILOW_NUM_ROUNDS + 1], outputs40[CHILOW_NUM_ROUNDS + 1];
+    int mismatches = 0;
+    
+    for (int trial = 0; trial < 64; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        chilow_integral_init_32bit(&integral32, tweak, key_hi, key_lo);
+        chilow_integral_init_40bit(&integral40, tweak, key_hi, key_lo);
+        
+        for (int input = 0; input < 8; input++) {
+            uint32_t c32 = (uint32_t)test_random();
+            uint64_t c40 = test_random() & 0xFFFFFFFFFFULL;
+            int rounds = input;
+            
+            if (chilow_integral_rounds_32bit(&integral32, c32, CHILOW_NUM_ROUNDS, outputs32) !=
+                chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, CHILOW_NUM_ROUNDS)) mismatches++;
+            if (chilow_integral_rounds_40bit(&integral40, c40, CHILOW_NUM_ROUNDS, outputs40) !=
+                chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, CHILOW_NUM_ROUNDS)) mismatches++;
+            for (int r = 0; r <= CHILOW_NUM_ROUNDS; r++) {
+                if (outputs32[r] != chilow_complete_rounds_32bit(c32, tweak, key_hi, key_lo, r)) mismatches++;
+                if (outputs40[r] != chilow_complete_rounds_40bit(c40, tweak, key_hi, key_lo, r)) mismatches++;
+            }
+            if (chilow_integral_rounds_32bit(&integral32, c32, rounds, NULL) != outputs32[rounds]) mismatches++;
+            if (chilow_integral_rounds_40bit(&integral40, c40, rounds, NULL) != outputs40[rounds]) mismatches++;
+        }
+    }
+    
+    printf("  Mismatches against the complete-round API: %d\n", mismatches);
+    print_test_result("Integral schedule matches complete rounds", mismatches == 0);
+}
+
+static void test_parameterized_engine(void) {
+    printf("\nParameterized Engine Tests:\n");
+    printf("===========================\n");
+    
+    static uint64_t c[700], tweaks[700], plaintexts[700], tags[700];
+    const size_t n = 700;
+    uint64_t key_hi = test_random(), key_lo = test_random();
+    chilow_spec_t spec;
+    chilow_engine_t engine;
+    int mismatches = 0;
+    
+    for (size_t i = 0; i < n; i++) {
+        c[i] = test_random();
+        tweaks[i] = test_random();
+    }
+    
+    /* Published variants, full and reduced rounds */
+    for (int rounds = 1; rounds <= 8; rounds++) {
+        chilow_spec_init_32bit(&spec);
+        spec.num_rounds = rounds;
+        if (chilow_engine_init(&engine, &spec, key_hi, key_lo) != 0) mismatches++;
+        chilow_engine_decrypt(&engine, c, tweaks, plaintexts, tags, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t expected = chilow_reduced_round_32bit((uint32_t)c[i], tweaks[i], key_hi, key_lo, rounds);
+            if (rounds == 8) expected = chilow_decrypt_32bit((uint32_t)c[i], tweaks[i], key_hi, key_lo);
+            if (plaintexts[i] != (expected & 0xFFFFFFFFULL) || tags[i] != (expected >> 32)) mismatches++;
+        }
+        
+        chilow_spec_init_40bit(&spec);
+        spec.num_rounds = rounds;
+        if (chilow_engine_init(&engine, &spec, key_hi, key_lo) != 0) mismatches++;
+        chilow_engine_decrypt(&engine, c, tweaks, plaintexts, NULL, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t expected = chilow_reduced_round_40bit(c[i] & 0xFFFFFFFFFFULL, tweaks[i], key_hi, key_lo, rounds);
+            if (rounds == 8) expected = chilow_decrypt_40bit(c[i] & 0xFFFFFFFFFFULL, tweaks[i], key_hi, key_lo);
+            if (plaintexts[i] != expected) mismatches++;
+        }
+    }
+    
+    /* Other widths and round counts: batch kernel against the scalar reference */
+    const int widths[] = {8, 24, 48, 64};
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        chilow_spec_init_32bit(&spec);
+        spec.state_width = widths[w];
+        spec.num_rounds = 12;
+        spec.round_constant_flags = 1ULL << 62;
+        if (chilow_engine_init(&engine, &spec, key_hi, key_lo) != 0) mismatches++;
+        chilow_engine_decrypt(&engine, c, tweaks, plaintexts, tags, n);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t tag, plaintext = chilow_engine_decrypt_block(&engine, c[i], tweaks[i], &tag);
+            if (plaintexts[i] != plaintext || tags[i] != tag) mismatches++;
+            if (widths[w] < 64 && (plaintext >> widths[w]) != 0) mismatches++;
+        }
+    }
+    
+    /* Invalid specs are rejected */
+    chilow_spec_init_32bit(&spec);
+    spec.state_width = 30 + 1;
+    if (chilow_engine_init(&engine, &spec, key_hi, key_lo) != -1) mismatches++;
+    spec.state_width = 32;
+    spec.num_rounds = 0;
+    if (chilow_engine_init(&engine, &spec, key_hi, key_lo) != -1) mismatches++;
+    
+    printf("  Mismatches (published variants, other widths, invalid specs): %d\n", mismatches);
+    print_test_result("Parameterized engine matches the fixed engines and its reference", mismatches == 0);
+}
+
+static void test_kernel_dispatch(void) {
+    printf("\nRuntime Kernel Dispatch Tests:\n");
+    printf("==============================\n");
+    
+    static const char* const names[] = {"scalar", "bmi2", "avx2", "avx512"};
+    static uint32_t c32[600];
+    static uint64_t c40[600], tweaks[600], results[600];
+    const char* selected = chilow_kernel_name();
+    chilow_ctx_t ctx;
+    int mismatches = 0, tested = 0;
+    
+    uint64_t key_hi = test_random(), key_lo = test_random();
+    chilow_ctx_init(&ctx, key_hi, key_lo);
+    for (int i = 0; i < 600; i++) {
+        c32[i] = (uint32_t)test_random();
+        c40[i] = test_random() & 0xFFFFFFFFFFULL;
+        tweaks[i] = test_random();
+    }
+    
+    printf("  Selected kernel: %s\n", selected);
+    for (int k = 0; k < 4; k++) {
+        if (chilow_set_kernel(names[k]) != 0) {
+            printf("  %-7s not supported on this CPU\n", names[k]);
+            continue;
+        }
+        int before = mismatches;
+        tested++;
+        if (chilow_decrypt_32bit(test_vectors_32[0].ciphertext, test_vectors_32[0].tweak,
+                                 test_vectors_32[0].key_hi, test_vectors_32[0].key_lo) !=
+            test_vectors_32[0].expected_result) mismatches++;
+        if (chilow_decrypt_40bit(test_vectors_40[0].ciphertext, test_vectors_40[0].tweak,
+                                 test_vectors_40[0].key_hi, test_vectors_40[0].key_lo) !=
+            test_vectors_40[0].expected_result) mismatches++;
+        
+        /* Reference: the expanded-key context, which does not go through the kernel table */
+        chilow_decrypt_32bit_bitsliced(c32, tweaks, key_hi, key_lo, results, 600);
+        for (int i = 0; i < 600; i++) {
+            uint64_t expected = chilow_ctx_decrypt_32bit(&ctx, c32[i], tweaks[i]);
+            if (results[i] != expected || chilow_decrypt_32bit(c32[i], tweaks[i], key_hi, key_lo) != expected) mismatches++;
+        }
+        chilow_decrypt_40bit_bitsliced(c40, tweaks, key_hi, key_lo, results, 600);
+        for (int i = 0; i < 600; i++) {
+            uint64_t expected = chilow_ctx_decrypt_40bit(&ctx, c40[i], tweaks[i]);
+            if (results[i] != expected || chilow_decrypt_40bit(c40[i], tweaks[i], key_hi, key_lo) != expected) mismatches++;
+        }
+        printf("  %-7s %s\n", names[k], mismatches == before ? "matches" : "MISMATCH");
+    }
+    chilow_set_kernel(selected);
+    
+    print_test_result("All supported kernels match the reference", tested > 0 && mismatches == 0 &&
+                      strcmp(chilow_kernel_name(), selected) == 0);
+}
+
+static void test_key_paths(void) {
+    printf("\nKey-Path Implementation Tests:\n");
+    printf("==============================\n");
+    
+    int mismatches = chilow_check_key_paths();
+    printf("  Key updates disagreeing with the two-word path: %d\n", mismatches);
+    print_test_result("Key-path implementations are bit-exact", mismatches == 0);
+}
+
+#ifdef CHILOW_JIT
+static void test_jit(void) {
+    printf("\nKey-Specialized JIT Tests:\n");
+    printf("==========================\n");
+    
+    chilow_jit_t jit;
+    int mismatches = 0, failures = 0, cache_hits = 0;
+    
+    for (int trial = 0; trial < 2; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random();
+        
+        /* Second init of the same key must come from the disk cache */
+        for (int load = 0; load < 2; load++) {
+            if (chilow_jit_init(&jit, key_hi, key_lo, NULL) != 0) {
+                failures++;
+                continue;
+            }
+            cache_hits += jit.from_cache;
+            static uint32_t c32[4096];
+            static uint64_t tweaks[4096], results[4096];
+            for (int i = 0; i < 4096; i++) {
+                c32[i] = (uint32_t)test_random();
+                tweaks[i] = test_random();
+            }
+            jit.decrypt_32bit_batch(c32, tweaks, results, 4096);
+            for (int i = 0; i < 4096; i++) {
+                uint64_t expected = chilow_decrypt_32bit(c32[i], tweaks[i], key_hi, key_lo);
+                if (jit.decrypt_32bit(c32[i], tweaks[i]) != expected || results[i] != expected) mismatches++;
+            }
+            chilow_jit_free(&jit);
+        }
+    }
+    
+    printf("  Build failures: %d, cache hits: %d/2, mismatches: %d\n", failures, cache_hits, mismatches);
+    print_test_result("JIT kernels match chilow_decrypt_32bit", failures == 0 && mismatches == 0 && cache_hits >= 2);
+    
+    /* Cache paths reach the compiler verbatim (no shell); readable directories are refused */
+    const char* base = getenv("CHILOW_JIT_CACHE");
+    char quoted_dir[1024], open_dir[1024];
+    struct stat info;
+    int quoted_ok = 0, open_refused = 0;
+    
+    if (base != NULL && base[0] != '\0') {
+        snprintf(quoted_dir, sizeof(quoted_dir), "%s/it's $(false)", base);
+        snprintf(open_dir, sizeof(open_dir), "%s/shared", base);
+        if (chilow_jit_init(&jit, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL, quoted_dir) == 0) {
+            quoted_ok = jit.decrypt_32bit(0x12345678, 1) ==
+                        chilow_decrypt_32bit(0x12345678, 1, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL);
+            chilow_jit_free(&jit);
+        }
+        mkdir(open_dir, 0700);
+        chmod(open_dir, 0755);
+        open_refused = stat(open_dir, &info) == 0 &&
+                       chilow_jit_init(&jit, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL, open_dir) != 0;
+    } else {
+        quoted_ok = open_refused = 1;
+    }
+    print_test_result("JIT cache path with shell metacharacters", quoted_ok);
+    print_test_result("JIT cache refuses a group/other-readable directory", open_refused);
+}
+#endif
+
+static void test_tweak_cache(void) {
+    printf("\nTweak Schedule Cache Tests:\n");
+    printf("===========================\n");
+    
+    static chilow_ctx_t ctx;
+    static chilow_tweak_cache_t cache;
+    uint64_t tweaks[16];
+    int mismatches = 0;
+    
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    chilow_tweak_cache_init(&cache, &ctx);
+    for (int i = 0; i < 16; i++) tweaks[i] = test_random();
+    
+    /* Repeated tweaks: one miss per (tweak, variant), hits afterwards */
+    for (int pass = 0; pass < 8; pass++) {
+        for (int i = 0; i < 16; i++) {
+            uint32_t c32 = (uint32_t)test_random();
+            uint64_t c40 = test_random() & 0xFFFFFFFFFFULL;
+            if (chilow_cached_decrypt_32bit(&cache, c32, tweaks[i]) != chilow_ctx_decrypt_32bit(&ctx, c32, tweaks[i])) mismatches++;
+            if (chilow_cached_decrypt_40bit(&cache, c40, tweaks[i]) != chilow_ctx_decrypt_40bit(&ctx, c40, tweaks[i])) mismatches++;
+        }
+    }
+    print_test_result("Cache hit/miss counters", cache.misses == 32 && cache.hits == 8 * 32 - 32);
+    
+    /* More distinct tweaks than slots: evictions must not change results */
+    for (int i = 0; i < 4 * CHILOW_TWEAK_CACHE_SLOTS; i++) {
+        uint64_t tweak = test_random();
+        uint32_t c32 = (uint32_t)test_random();
+        if (chilow_cached_decrypt_32bit(&cache, c32, tweak) != chilow_ctx_decrypt_32bit(&ctx, c32, tweak)) mismatches++;
+        if (chilow_cached_decrypt_32bit(&cache, c32, tweaks[i % 16]) != chilow_ctx_decrypt_32bit(&ctx, c32, tweaks[i % 16])) mismatches++;
+    }
+    
+    printf("  Hits: %llu, misses: %llu\n", (unsigned long long)cache.hits, (unsigned long long)cache.misses);
+    printf("  Mismatches against the context API: %d\n", mismatches);
+    print_test_result("Cached decryption matches context API", mismatches == 0);
+}
+
+static void test_encryption(void) {
+    printf("\nEncryption Tests:\n");
+    printf("=================\n");
+    
+    int mismatches = 0;
+    const test_vector_32_t* v32 = &test_vectors_32[0];
+    const test_vector_40_t* v40 = &test_vectors_40[0];
+    
+    /* Specification vectors in the encryption direction */
+    uint64_t enc32 = chilow_encrypt_32bit((uint32_t)v32->expected_result, v32->tweak, v32->key_hi, v32->key_lo);
+    uint64_t enc40 = chilow_encrypt_40bit(v40->expected_result, v40->tweak, v40->key_hi, v40->key_lo);
+    printf("  32-bit: 0x%016llx (expected ciphertext 0x%08x, tag 0x%08x)\n",
+           (unsigned long long)enc32, (unsigned)v32->ciphertext, (unsigned)(v32->expected_result >> 32));
+    printf("  40-bit: 0x%010llx (expected ciphertext 0x%010llx)\n",
+           (unsigned long long)enc40, (unsigned long long)v40->ciphertext);
+    print_test_result("Encryption of specification vectors",
+                      enc32 == (((v32->expected_result >> 32) << 32) | v32->ciphertext) && enc40 == v40->ciphertext);
+    
+    /* Round trips in both directions with random keys, tweaks and blocks */
+    for (int trial = 0; trial < 1000; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        uint32_t m32 = (uint32_t)test_random();
+        uint64_t m40 = test_random() & 0xFFFFFFFFFFULL;
+        
+        uint64_t c32 = chilow_encrypt_32bit(m32, tweak, key_hi, key_lo);
+        uint64_t d32 = chilow_decrypt_32bit((uint32_t)c32, tweak, key_hi, key_lo);
+        if ((uint32_t)d32 != m32 || (d32 >> 32) != (c32 >> 32)) mismatches++;
+        if (chilow_decrypt_40bit(chilow_encrypt_40bit(m40, tweak, key_hi, key_lo), tweak, key_hi, key_lo) != m40) mismatches++;
+        
+        d32 = chilow_decrypt_32bit(m32, tweak, key_hi, key_lo);
+        if (chilow_encrypt_32bit((uint32_t)d32, tweak, key_hi, key_lo) != (((d32 >> 32) << 32) | m32)) mismatches++;
+        if (chilow_encrypt_40bit(chilow_decrypt_40bit(m40, tweak, key_hi, key_lo), tweak, key_hi, key_lo) != m40) mismatches++;
+    }
+    
+    printf("  Round-trip mismatches: %d\n", mismatches);
+    print_test_result("Encryption inverts decryption", mismatches == 0);
+}
+
+#ifndef CHILOW_LINEAR_MATRIX
+/* Runs before chilow_init(): everything here must work on compile-time layers alone */
+static void test_without_init(void) {
+    printf("\nBefore chilow_init():\n");
+    printf("=====================\n");
+    
+    int mismatches = 0;
+    const test_vector_32_t* v32 = &test_vectors_32[0];
+    const test_vector_40_t* v40 = &test_vectors_40[0];
+    
+    if (chilow_encrypt_32bit((uint32_t)v32->expected_result, v32->tweak, v32->key_hi, v32->key_lo) !=
+        (((v32->expected_result >> 32) << 32) | v32->ciphertext)) mismatches++;
+    if (chilow_encrypt_40bit(v40->expected_result, v40->tweak, v40->key_hi, v40->key_lo) != v40->ciphertext) {
+        mismatches++;
+    }
+    for (int trial = 0; trial < 100; trial++) {
+        uint64_t key_hi = test_random(), key_lo = test_random(), tweak = test_random();
+        uint32_t m32 = (uint32_t)test_random();
+        uint64_t m40 = test_random() & 0xFFFFFFFFFFULL;
+        
+        uint64_t c32 = chilow_encrypt_32bit(m32, tweak, key_hi, key_lo);
+        uint64_t d32 = chilow_decrypt_32bit((uint32_t)c32, tweak, key_hi, key_lo);
+        if ((uint32_t)d32 != m32 || (d32 >> 32) != (c32 >> 32)) mismatches++;
+        if (chilow_decrypt_40bit(chilow_encrypt_40bit(m40, tweak, key_hi, key_lo), tweak, key_hi, key_lo) != m40) mismatches++;
+    }
+    
+    printf("  Mismatches: %d\n", mismatches);
+    print_test_result("Encryption round trip without chilow_init()", mismatches == 0);
+    
+    /* Lane-parallel decryption with per-block keys (full vector steps and a scalar tail) */
+    static uint32_t c32[37];
+    static uint64_t c40[37], tweaks[37], keys_hi[37], keys_lo[37], out32[37], out40[37];
+    
+    mismatches = 0;
+    for (size_t i = 0; i < 37; i++) {
+        c32[i] = (uint32_t)test_random();
+        c40[i] = test_random() & 0xFFFFFFFFFFULL;
+        tweaks[i] = test_random();
+        keys_hi[i] = test_random();
+        keys_lo[i] = test_random();
+    }
+    chilow_decrypt_32bit_lanes(c32, tweaks, keys_hi, keys_lo, out32, 37);
+    chilow_decrypt_40bit_lanes(c40, tweaks, keys_hi, keys_lo, out40, 37);
+    for (size_t i = 0; i < 37; i++) {
+        if (out32[i] != chilow_decrypt_32bit(c32[i], tweaks[i], keys_hi[i], keys_lo[i])) mismatches++;
+        if (out40[i] != chilow_decrypt_40bit(c40[i], tweaks[i], keys_hi[i], keys_lo[i])) mismatches++;
+    }
+    
+    printf("  Lane decryption mismatches: %d\n", mismatches);
+    print_test_result("Lane-parallel decryption without chilow_init()", mismatches == 0);
+    
+    /* Strided batch with per-record keys (goes through the lane kernels) */
+    typedef struct {
+        uint32_t c32;
+        uint64_t c40, tweak, key_hi, key_lo, result;
+    } record_t;
+    static record_t records[37];
+    
+    mismatches = 0;
+    for (int variant_40 = 0; variant_40 < 2; variant_40++) {
+        chilow_strided_t batch = {
+            variant_40 ? (const void*)&records[0].c40 : (const void*)&records[0].c32, sizeof(record_t),
+            &records[0].tweak, sizeof(record_t),
+            &records[0].key_hi, &records[0].key_lo, sizeof(record_t), &records[0].result, sizeof(record_t)
+        };
+        for (size_t i = 0; i < 37; i++) {
+            records[i].c32 = c32[i];
+            records[i].c40 = c40[i];
+            records[i].tweak = tweaks[i];
+            records[i].key_hi = keys_hi[i];
+            records[i].key_lo = keys_lo[i];
+        }
+        if (variant_40) {
+            chilow_decrypt_40bit_strided(&batch, 37);
+        } else {
+            chilow_decrypt_32bit_strided(&batch, 37);
+        }
+        for (size_t i = 0; i < 37; i++) {
+            uint64_t expected = variant_40 ? chilow_decrypt_40bit(c40[i], tweaks[i], keys_hi[i], keys_lo[i])
+                                           : chilow_decrypt_32bit(c32[i], tweaks[i], keys_hi[i], keys_lo[i]);
+            if (records[i].result != expected) mismatches++;
+        }
+    }
+    
+    printf("  Strided decryption mismatches: %d\n", mismatches);
+    print_test_result("Strided batch with per-record keys without chilow_init()", mismatches == 0);
+    
+    /* Memory encryption under a context (lane kernels for full steps, scalar for the rest) */
+    static uint32_t plaintexts[37], ciphertexts[37], tags[37], decrypted[37];
+    const uint64_t address = 0x7F3A12345676ULL, domain = 0x5A;
+    chilow_ctx_t ctx;
+    
+    mismatches = 0;
+    chilow_ctx_init(&ctx, test_random(), test_random());
+    for (size_t i = 0; i < 37; i++) plaintexts[i] = (uint32_t)test_random();
+    chilow_memory_encrypt_32bit(&ctx, address, domain, plaintexts, ciphertexts, tags, 37);
+    for (size_t i = 0; i < 37; i++) {
+        uint64_t expected = chilow_encrypt_32bit(plaintexts[i], chilow_memory_tweak(address, i, domain),
+                                                 ctx.key_hi, ctx.key_lo);
+        if (ciphertexts[i] != (uint32_t)expected || tags[i] != (uint32_t)(expected >> 32)) mismatches++;
+    }
+    if (chilow_memory_decrypt_32bit(&ctx, address, domain, ciphertexts, tags, decrypted, 37) != 0) mismatches++;
+    if (memcmp(decrypted, plaintexts, sizeof(plaintexts)) != 0) mismatches++;
+    
+    printf("  Memory encryption mismatches: %d\n", mismatches);
+    print_test_result("Memory encryption without chilow_init()", mismatches == 0);
+    
+    /* Pointer signing under the same context */
+    static uint64_t pointers[37], contexts[37], signed_pointers[37], restored[37];
+    const chilow_pac_t pac = {0xFFFF000000000000ULL, 0xA5C3000000000000ULL, 0xF};
+    
+    mismatches = 0;
+    for (size_t i = 0; i < 37; i++) {
+        pointers[i] = test_random() & 0x00007FFFFFFFFFF0ULL;
+        contexts[i] = test_random();
+    }
+    chilow_pac_sign_40bit(&ctx, &pac, pointers, contexts, signed_pointers, 37);
+    for (size_t i = 0; i < 37; i++) {
+        uint64_t high = (pointers[i] & 0x0000FF0000000000ULL) | pac.check;
+        uint64_t low = chilow_encrypt_40bit(pointers[i] & 0xFFFFFFFFFFULL, contexts[i] ^ high, ctx.key_hi, ctx.key_lo);
+        if (signed_pointers[i] != (high | low)) mismatches++;
+    }
+    if (chilow_pac_auth_40bit(&ctx, &pac, signed_pointers, contexts, restored, 37) != 0) mismatches++;
+    if (memcmp(restored, pointers, sizeof(pointers)) != 0) mismatches++;
+    
+    printf("  Pointer signing mismatches: %d\n", mismatches);
+    print_test_result("Pointer signing without chilow_init()", mismatches == 0);
+}
+#endif
+
 static void performance_test(void) {
     printf("\nBasic Performance Test:\n");
     printf("=======================\n");
@@ -203,22 +1299,22 @@ static void test_reduced_rounds(void) {
     uint64_t key_hi = 0xFEDCBA9876543210ULL;
     uint64_t key_lo = 0x7766554433221100ULL;
     
+    chilow_round_sweep_t sweep32, sweep40;
+    chilow_round_sweep_32bit(c32, tweak, key_hi, key_lo, &sweep32);
+    chilow_round_sweep_40bit(c40, tweak, key_hi, key_lo, &sweep40);
+    
     printf("\n32-bit reduced round tests:\n");
     for (int rounds = 1; rounds <= 8; rounds++) {
-        uint64_t result_reduced = chilow_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds);
-        uint64_t result_half = chilow_half_reduced_round_32bit(c32, tweak, key_hi, key_lo, rounds);
-        
         printf("  %d rounds: 0x%016llX (half: 0x%016llX)\n", 
-               rounds, (unsigned long long)result_reduced, (unsigned long long)result_half);
+               rounds, (unsigned long long)sweep32.reduced[rounds],
+               (unsigned long long)sweep32.half_reduced[rounds]);
     }
     
     printf("\n40-bit reduced round tests:\n");
     for (int rounds = 1; rounds <= 8; rounds++) {
-        uint64_t result_reduced = chilow_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds);
-        uint64_t result_half = chilow_half_reduced_round_40bit(c40, tweak, key_hi, key_lo, rounds);
-        
         printf("  %d rounds: 0x%010llX (half: 0x%010llX)\n", 
-               rounds, (unsigned long long)result_reduced, (unsigned long long)result_half);
+               rounds, (unsigned long long)sweep40.reduced[rounds],
+               (unsigned long long)sweep40.half_reduced[rounds]);
     }
     
     /* Verify that 8 rounds gives the same result as the full function */
@@ -253,14 +1349,42 @@ int main(void) {
     printf("ChiLow Independent Implementation - Test Suite\n");
     printf("==============================================\n");
     
+#ifndef CHILOW_LINEAR_MATRIX
+    /* The reference matrices are only filled by chilow_init() */
+    test_without_init();
+#endif
+    
     /* Initialize the implementation */
     chilow_init();
     
     /* Run all tests */
     test_32bit_vectors();
     test_40bit_vectors();
+    test_linear_layers();
     test_edge_cases();
     test_reduced_rounds();
+    test_bitsliced_batch();
+    test_lane_batch();
+    test_bulk_decryption();
+    test_strided_batch();
+    test_tag_verification();
+    test_memory_encryption();
+    test_pointer_authentication();
+    test_prf_keystream();
+    test_expanded_key_context();
+    test_kernel_dispatch();
+    test_parameterized_engine();
+    test_round_sweep();
+    test_round_trace();
+    test_cube_enumerator();
+    test_cube_sum();
+    test_integral_schedule();
+    test_key_paths();
+    test_tweak_cache();
+    test_encryption();
+#ifdef CHILOW_JIT
+    test_jit();
+#endif
     performance_test();
     
     /* Print summary */